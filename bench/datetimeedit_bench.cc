@@ -0,0 +1,300 @@
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMouseEvent>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <vector>
+
+#include "calendarwidget.h"
+#include "datetimeedit.h"
+#include "datetimepicker.h"
+#include "daychangenotifier.h"
+
+/**
+ * @brief ؼܲ: λ/p99ʱڴ, JSONڰ汾Ա
+ *
+ * usage: datetimeedit-bench [iterations] [output.json]
+ */
+
+namespace {
+
+// Counts every allocation of the process, including the ones made inside Qt and the library.
+// Replacing the global operator new in the executable only reaches shared libraries on ELF
+// platforms; elsewhere the counts cover the benchmark itself.
+std::atomic<unsigned long long> g_allocations(0);
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+constexpr int kMonthFlips = 1000;
+constexpr int kRangeClicks = 100;
+constexpr int kRolloverTables = 100;
+
+struct ScenarioResult
+{
+    QString name;
+    QString unit;
+    std::vector<qint64> samples; // ns per iteration
+    unsigned long long allocations;
+};
+
+// Runs body once untimed, then `iterations` timed rounds; reset (if any) runs untimed after each round.
+ScenarioResult runScenario(const QString& name, const QString& unit, int iterations,
+                           const std::function<void(int)>& body, const std::function<void()>& reset = nullptr)
+{
+    ScenarioResult result{name, unit, {}, 0};
+    result.samples.reserve(iterations);
+
+    body(-1);
+    if (reset)
+        reset();
+
+    for (int i = 0; i < iterations; ++i) {
+        unsigned long long allocations = g_allocations.load(std::memory_order_relaxed);
+        QElapsedTimer timer;
+        timer.start();
+
+        body(i);
+
+        result.samples.push_back(timer.nsecsElapsed());
+        result.allocations += g_allocations.load(std::memory_order_relaxed) - allocations;
+
+        if (reset)
+            reset();
+    }
+
+    return result;
+}
+
+QJsonObject toJson(ScenarioResult result)
+{
+    std::vector<qint64>& samples = result.samples;
+    std::sort(samples.begin(), samples.end());
+
+    size_t count = samples.size();
+    size_t p99_index = size_t(std::ceil(count * 0.99)) - 1;
+    double mean = 0;
+    for (qint64 sample : samples) {
+        mean += double(sample) / count;
+    }
+
+    QJsonObject object;
+    object["name"] = result.name;
+    object["unit"] = result.unit;
+    object["iterations"] = int(count);
+    object["median_ns"] = double(samples[count / 2]);
+    object["p99_ns"] = double(samples[p99_index]);
+    object["mean_ns"] = mean;
+    object["min_ns"] = double(samples.front());
+    object["max_ns"] = double(samples.back());
+    object["allocations_per_iteration"] = double(result.allocations) / count;
+    return object;
+}
+
+// editBtnClicked() toggles the popup, the same slot the calendar button triggers.
+void togglePopup(DateTimeEdit* edit)
+{
+    QMetaObject::invokeMethod(edit, "editBtnClicked", Qt::DirectConnection);
+    QApplication::processEvents();
+}
+
+// Sends a press/release pair to the cell and waits until the click is committed and painted.
+void clickCell(CalendarTable* table, int row, int column)
+{
+    QWidget* viewport = table->viewport();
+    QPoint pos(table->columnViewportPosition(column) + table->columnWidth(column) / 2,
+               table->rowViewportPosition(row) + table->rowHeight(row) / 2);
+    QDate date = table->model()->index(row, column).data(CalendarTable::kDate).toDate();
+
+    QMouseEvent press(QEvent::MouseButtonPress, pos, viewport->mapToGlobal(pos), Qt::LeftButton, Qt::LeftButton,
+                      Qt::NoModifier);
+    QApplication::sendEvent(viewport, &press);
+    QMouseEvent release(QEvent::MouseButtonRelease, pos, viewport->mapToGlobal(pos), Qt::LeftButton, Qt::NoButton,
+                        Qt::NoModifier);
+    QApplication::sendEvent(viewport, &release);
+
+    while (!table->selected_date().contains(date)) {
+        QApplication::processEvents(QEventLoop::WaitForMoreEvents, 1);
+    }
+    viewport->repaint();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+
+    int iterations = argc > 1 ? QString(argv[1]).toInt() : 50;
+    if (iterations <= 0)
+        iterations = 50;
+    QString output = argc > 2 ? QString(argv[2]) : QString();
+
+    const QDate kStartDate(2024, 3, 2);
+    QJsonArray scenarios;
+
+    const struct
+    {
+        DateTimeEdit::DateEditType type;
+        const char* name;
+    } edit_types[] = {
+        {DateTimeEdit::kDateTime, "construct_date_time"},
+        {DateTimeEdit::kDate, "construct_date"},
+        {DateTimeEdit::kDateTimeRange, "construct_date_time_range"},
+        {DateTimeEdit::kDateRange, "construct_date_range"},
+    };
+    for (const auto& edit_type : edit_types) {
+        scenarios.append(toJson(runScenario(edit_type.name, "construct + destroy", iterations, [&](int) {
+            DateTimeEdit edit(nullptr, edit_type.type, kStartDate.year(), kStartDate.month());
+        })));
+    }
+
+    {
+        DateTimeEdit edit(nullptr, DateTimeEdit::kDateTime, kStartDate.year(), kStartDate.month());
+        edit.show();
+        QApplication::processEvents();
+
+        // رղʱ
+        scenarios.append(toJson(runScenario(
+            "open_popup", "open", iterations, [&](int) { togglePopup(&edit); }, [&]() { togglePopup(&edit); })));
+    }
+
+    {
+        CalendarTable table(nullptr, kStartDate.year(), kStartDate.month());
+        table.resize(215, 180);
+
+        // ǰ淭ҳ, ڷΧ
+        scenarios.append(toJson(runScenario("flip_1000_months", "1000 setYearMonth", iterations, [&](int i) {
+            int step = (i & 1) ? -1 : 1;
+            for (int n = 0; n < kMonthFlips; ++n) {
+                table.setYearMonth(table.year(), table.month() + step);
+            }
+        })));
+    }
+
+    {
+        DateTimeRangePicker picker(nullptr, kStartDate.year(), kStartDate.month());
+        picker.show();
+        QApplication::processEvents();
+
+        auto tables = picker.findChildren<CalendarTable*>();
+        if (tables.size() == 2) {
+            CalendarTable* start_table = tables.at(0);
+            CalendarTable* end_table = tables.at(1);
+
+            // ʼ, ΧѡĿʼ/;
+            // ÿεһβͬĵԪ, ȡѡ
+            scenarios.append(toJson(runScenario("range_picker_clicks", "100 start/end clicks", iterations, [&](int) {
+                for (int n = 0; n < kRangeClicks; n += 2) {
+                    int column = (n / 2) % 2;
+                    clickCell(start_table, 2, column);
+                    clickCell(end_table, 3, column + 4);
+                }
+            })));
+        }
+    }
+
+    const struct
+    {
+        CalendarTable::ClickCommitMode mode;
+        const char* name;
+    } commit_modes[] = {
+        {CalendarTable::kDeferredCommit, "click_latency_deferred"},
+        {CalendarTable::kSpeculativeCommit, "click_latency_immediate"},
+    };
+    for (const auto& commit_mode : commit_modes) {
+        CalendarTable table(nullptr, kStartDate.year(), kStartDate.month());
+        table.resize(215, 180);
+        table.setClickCommitMode(commit_mode.mode);
+        table.show();
+        QApplication::processEvents();
+
+        // ѡģʽ½, Ӱµػ
+        scenarios.append(toJson(runScenario(commit_mode.name, "click to repaint", iterations, [&](int i) {
+            clickCell(&table, 2, (i & 1) ? 3 : 1);
+        })));
+    }
+
+    {
+        // ģ: ʱ֮л, ֻˢ¾""Ԫ
+        QWidget parent;
+        for (int n = 0; n < kRolloverTables; ++n) {
+            new CalendarTable(&parent, kStartDate.year(), kStartDate.month());
+        }
+
+        DayChangeNotifier* notifier = DayChangeNotifier::Instance();
+        scenarios.append(toJson(runScenario("midnight_rollover", "100 calendars", iterations, [&](int i) {
+            QDateTime now(kStartDate.addDays(i & 1), QTime(0, 0, 1));
+            notifier->setClock([now]() { return now; });
+        })));
+        notifier->setClock(DayChangeNotifier::Clock());
+    }
+
+    {
+        CalendarWidget widget(nullptr, kStartDate.year(), kStartDate.month());
+        widget.resize(215, 230);
+        widget.addSelectedDate(kStartDate);
+        widget.setSpecialDate({kStartDate.addDays(-9), kStartDate.addDays(-3), kStartDate.addDays(5)});
+
+        QImage image(widget.size(), QImage::Format_ARGB32_Premultiplied);
+        scenarios.append(toJson(runScenario("render_calendar_widget", "render to QImage", iterations, [&](int) {
+            image.fill(Qt::transparent);
+            widget.render(&image);
+        })));
+    }
+
+    // ÿĿؼ
+    int calendar_widget_children = 0;
+    {
+        CalendarWidget widget(nullptr, kStartDate.year(), kStartDate.month());
+        calendar_widget_children = widget.findChildren<QWidget*>().size();
+    }
+
+    QJsonObject report;
+    report["qt_version"] = QString(qVersion());
+    report["platform"] = QGuiApplication::platformName();
+    report["iterations"] = iterations;
+    report["calendar_widget_children"] = calendar_widget_children;
+    report["scenarios"] = scenarios;
+
+    QByteArray json = QJsonDocument(report).toJson();
+    std::fwrite(json.constData(), 1, size_t(json.size()), stdout);
+
+    if (!output.isEmpty()) {
+        QFile file(output);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "cannot write %s\n", qPrintable(output));
+            return 1;
+        }
+        file.write(json);
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "calendartable.h"
+
+/**
+ * @brief ԪƺʱԱ: ɵİɫȡQVariant + ͼԪsave()/restore(), 뵱ǰCalendarDelegate
+ *
+ * usage: calendar-paint-bench [frames]
+ */
+
+namespace {
+
+constexpr int kCellWidth = 30;
+constexpr int kCellHeight = 26;
+constexpr int kRuns = 7;
+
+// CalendarDelegate::paint before the packed cell style, kept as the baseline.
+class LegacyCalendarDelegate : public DrawBaseDelegate
+{
+public:
+    explicit LegacyCalendarDelegate(QObject* parent)
+        : DrawBaseDelegate(parent)
+    {}
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override
+    {
+        QVariant alpha_data = index.data(CalendarTable::kAlpha);
+        double color_alpha = alpha_data.canConvert<double>() ? alpha_data.toDouble() : 1.0;
+        if (!(QStyle::State_Enabled & option.state)) {
+            color_alpha *= 0.5;
+        }
+
+        QColor tmp_color;
+
+        bool draw_bg = colorByRole(index, CalendarTable::kBgColor, color_alpha, tmp_color);
+        if (draw_bg) {
+            drawBackgroud(painter, option.rect, tmp_color);
+        }
+
+        if (colorByRole(index, CalendarTable::kBorderColor, color_alpha, tmp_color)) {
+            drawBorder(painter, option.rect, tmp_color);
+        }
+
+        colorByRole(index, CalendarTable::kHoverBorderColor, color_alpha, tmp_color);
+
+        if (colorByRole(index, CalendarTable::kFontColor, color_alpha, tmp_color)) {
+            drawText(painter, option.rect, tmp_color, index.data().toString());
+        }
+
+        if (colorByRole(index, CalendarTable::kPointColor, color_alpha, tmp_color)) {
+            QRect tmp_rect(option.rect.x() + option.rect.width() / 2 - 1,
+                           option.rect.y() + option.rect.height() * 6 / 7 - 1, 2, 2);
+            drawPoint(painter, tmp_rect, tmp_color);
+        }
+    }
+
+private:
+    bool colorByRole(const QModelIndex& model_index, int role, double alpha, QColor& tmp_color) const
+    {
+        QVariant var = model_index.data(role);
+        if (var.canConvert<QColor>()) {
+            tmp_color = var.value<QColor>();
+            if (alpha) {
+                tmp_color.setAlphaF(alpha);
+            }
+            return true;
+        }
+        return false;
+    }
+};
+
+// Median paint cost of one cell in nanoseconds, a frame paints all cells with one QPainter.
+double paintCostPerCell(QAbstractItemDelegate* delegate, QAbstractItemModel* model, int frames)
+{
+    int rows = model->rowCount();
+    int columns = model->columnCount();
+    QImage image(kCellWidth * columns, kCellHeight * rows, QImage::Format_ARGB32_Premultiplied);
+
+    QStyleOptionViewItem option;
+    option.state = QStyle::State_Enabled;
+
+    std::vector<double> costs;
+    for (int run = 0; run < kRuns; ++run) {
+        QElapsedTimer timer;
+        timer.start();
+
+        for (int frame = 0; frame < frames; ++frame) {
+            image.fill(Qt::transparent);
+            QPainter painter(&image);
+            for (int row = 0; row < rows; ++row) {
+                for (int column = 0; column < columns; ++column) {
+                    option.rect = QRect(column * kCellWidth, row * kCellHeight, kCellWidth, kCellHeight);
+                    delegate->paint(&painter, option, model->index(row, column));
+                }
+            }
+        }
+
+        costs.push_back(double(timer.nsecsElapsed()) / (double(frames) * rows * columns));
+    }
+
+    std::sort(costs.begin(), costs.end());
+    return costs[costs.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+
+    int frames = argc > 1 ? QString(argv[1]).toInt() : 2000;
+    if (frames <= 0)
+        frames = 2000;
+
+    QDate today = QDate::currentDate();
+    CalendarTable table(nullptr, today.year(), today.month());
+    table.addSelectedDate(today);
+    table.setSpecialDate({today.addDays(-9), today.addDays(-3), today.addDays(5)});
+
+    LegacyCalendarDelegate legacy_delegate(&table);
+
+    double legacy_cost = paintCostPerCell(&legacy_delegate, table.model(), frames);
+    double packed_cost = paintCostPerCell(table.itemDelegate(), table.model(), frames);
+
+    std::printf("frames: %d, cells per frame: %d\n", frames, table.model()->rowCount() * table.model()->columnCount());
+    std::printf("legacy (QVariant roles, save/restore): %8.1f ns/cell\n", legacy_cost);
+    std::printf("packed (CalendarCellStyle):            %8.1f ns/cell\n", packed_cost);
+    std::printf("speedup: %.2fx\n", packed_cost > 0 ? legacy_cost / packed_cost : 0.0);
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#ifndef CALENDARDATAPROVIDER_H_
+#define CALENDARDATAPROVIDER_H_
+
+#include <QDate>
+#include <QFuture>
+#include <QList>
+
+#include "datetimeedit_global.h"
+
+/**
+ * @brief ṩҪǵ(¼񡢸澯), ʾ·ݱ仯ʱ
+ * ̲߳ѯ(QtConcurrent::run), صQFutureɺGUI̸߳±;
+ * ûҳҪᱻcancel(), ʱĲѯɼȡ״̬ǰ
+ */
+class DATETIMEEDIT_EXPORT CalendarDataProvider
+{
+public:
+    virtual ~CalendarDataProvider() = default;
+
+    // yearmonthҪǵ, ڸµڽ
+    virtual QFuture<QList<QDate>> fetchMonth(int year, int month) = 0;
+
+    // ڴʱֱӷɵQFuture
+    static QFuture<QList<QDate>> readyResult(const QList<QDate>& dates);
+};
+
+#endif // CALENDARDATAPROVIDER_H_
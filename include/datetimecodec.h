@@ -0,0 +1,68 @@
+#ifndef DATETIMECODEC_H_
+#define DATETIMECODEC_H_
+
+#include <QDateTime>
+#include <QString>
+
+#include "datetimeedit_global.h"
+
+/**
+ * @brief ڸʽ(yyyy-MM-dd hh:mm:ssyyyy-MM-dd)Ŀٽʽ
+ * ʽֻyyyyMMddhh/HHmmssĸASCIIָʱ̶λöд, ʽ˵QDateTime::fromString/toString
+ *
+ * ӿڵȴ, ʱ""ʾ: 1970-01-01 00:00:00, ʱ
+ */
+class DATETIMEEDIT_EXPORT DateTimeCodec
+{
+public:
+    static constexpr qint64 kInvalidSecs = Q_INT64_C(-9223372036854775807) - 1;
+
+    explicit DateTimeCodec(const QString& format = QString("yyyy-MM-dd hh:mm:ss"));
+
+    const QString& format() const { return format_; }
+    bool isFixedLayout() const { return fixed_; }
+    // ʽַ, ǶʽΪ0
+    int width() const { return width_; }
+
+    QString toString(const QDateTime& date_time) const;
+    QDateTime fromString(const QString& text) const;
+
+    // ÿ¼width()ֽ, ڼ¼stride(>= width())ֽ, ʽ
+    // سɹ; ޷ʾʱ(ݲ0-9999)дΪո, ޷ıkInvalidSecs
+    int formatBatch(const qint64* secs, int count, char* out, int stride) const;
+    int parseBatch(const char* text, int count, int stride, qint64* secs) const;
+
+private:
+    enum Field
+    {
+        kYear,
+        kMonth,
+        kDay,
+        kHour,
+        kMinute,
+        kSecond,
+        kFieldCount
+    };
+
+    static constexpr int kChunkCount = 4;
+    static constexpr int kMaxWidth = kChunkCount * 8;
+
+    void parseLayout();
+    bool parseFields(const char* text, int fields[kFieldCount]) const;
+    void formatFields(const int fields[kFieldCount], char* out) const;
+
+private:
+    QString format_;
+    bool fixed_;
+    int width_;
+    int chunk_count_;
+    qint8 offsets_[kFieldCount]; // ֶεʼλ, Ϊ-1
+
+    // 8ֽڷֿУ: ָȫһ, λΪ'0'-'9'
+    char pattern_[kMaxWidth];
+    quint64 literals_[kChunkCount];
+    quint64 literal_masks_[kChunkCount];
+    quint64 digit_masks_[kChunkCount];
+};
+
+#endif // DATETIMECODEC_H_
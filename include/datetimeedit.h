@@ -6,7 +6,9 @@
 #include <QScrollBar>
 
 #include "calendarwidget.h"
+#include "datetimecodec.h"
 #include "datetimepicker.h"
+#include "perfcounters.h"
 
 /**
  * @brief ڱ༭ؼ
@@ -29,6 +31,7 @@ public:
 
     DateTimeEdit(QWidget* parent, DateEditType type = kDateTime, int year = QDate::currentDate().year(),
                  int month = QDate::currentDate().month());
+    ~DateTimeEdit() override;
 
     void setDate(const QDate& date);
     void setDateTime(const QDateTime& date_time);
@@ -37,21 +40,35 @@ public:
     void setDateTimeRange(const QDateTime& start, const QDateTime& end);
     void resetDateTime();
 
+    // : ͬһ㴰ͬ͵ı༭һѡ, ʱ󶨵ǰ༭; Ĭϲ
+    void setPopupShared(bool shared);
+    bool isPopupShared() const { return popup_shared_; }
+
+    void setMinDate(const QDate& date);
+    void setMaxDate(const QDate& date);
+    void setSpecialDate(const QList<QDate>& dates);
+
     QDate date();
     QList<QDate> selected_date();
     QTime time();
-    QDateTime start_date_time();
-    QDateTime end_date_time();
+    QDateTime start_date_time() { return start_date_time_; }
+    QDateTime end_date_time() { return end_date_time_; }
+    QDate min_date() { return min_date_; }
+    QDate max_date() { return max_date_; }
+    QList<QDate> special_date() { return special_dates_; }
 
     bool isValidDateTimeRange();
     bool isDifferentYearOrMonth();
 
+    // 򿪼༭ѡͬĺʱ, ˢƼCalendarTable::perfCounters(); δʱΪnullptr
+    PerfCounters* perfCounters() { return perf_counters_; }
+
 signals:
     void startDateTimeChanged(const QDateTime& date_time);
     void endDateTimeChanged(const QDateTime& dateTim);
 
 protected:
-    void resizeEvent(QResizeEvent* event) override;
+    bool event(QEvent* event) override;
     bool eventFilter(QObject* watched, QEvent* event) override;
 
 private slots:
@@ -67,24 +84,40 @@ private slots:
 private:
     void initDateFormat(DateEditType type, int year, int month);
     void setCursorPosInVisivle(SimpleDateTimeEdit* simple_edit, int index);
+    static QFrame* createPopup(QWidget* parent, DateEditType type);
+    QWidget* createPicker(QFrame* popup);
+    void ensurePicker();
+    void bindSharedPopup();
+    void bindPicker(QFrame* popup, QWidget* picker);
+    void unbindPicker();
+    void applyDateLimits();
+    QDateTime normalized(const QDateTime& date_time) const;
+    QString displayText() const;
 
 private:
     SimpleDateTimeEdit* start_edit_;
     SimpleDateTimeEdit* end_edit_;
     QScrollArea* scroll_area_;
 
+    // һδ򿪵ʱŴ, ֻtype_Ӧѡ; ǰ༭Ϊȫ״̬
+    // ʱָDateTimePopupPoolеĵ, ڰڼЧ
     QFrame* popup_widget_;
-    QStackedLayout* stacked_layout_;
+    DateTimePicker* picker_;            // kDateTime, kDate
+    DateTimeRangePicker* range_picker_; // kDateTimeRange, kDateRange
+    bool popup_shared_;
 
-    DateTimePicker* date_time_picker_;
-    DatePicker* date_picker_;
-    DateTimeRangePicker* date_time_range_picker_;
-    DateRangePicker* date_range_picker_;
+    QDate min_date_;
+    QDate max_date_;
+    QList<QDate> special_dates_;
 
     QString date_format_;
-    QString real_text_;
+    DateTimeCodec codec_; // date_format_Ӧı
+    // ǰֵ, ༭ıʾֻʾʱʽ; ֻʹstart_date_time_
+    QDateTime start_date_time_;
+    QDateTime end_date_time_;
 
     DateEditType type_;
+    PerfCounters* perf_counters_;
 };
 
 #endif // DateTimeEdit_H_
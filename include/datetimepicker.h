@@ -6,7 +6,7 @@
 
 #include "calendarwidget.h"
 
-class DateTimePicker : public QWidget
+class DATETIMEEDIT_EXPORT DateTimePicker : public QWidget
 {
     Q_OBJECT
 public:
@@ -20,6 +20,9 @@ public:
     QList<QDate> selected_date() { return calendar_widget_->selected_date(); };
     QTime time() { return time_edit_->time(); }
 
+    void setDateLimits(const QDate& min_date, const QDate& max_date);
+    void setSpecialDate(const QList<QDate>& dates) { calendar_widget_->setSpecialDate(dates); }
+
 signals:
     void timeChanged(const QTime& time);
     void dateChanged(const QDate& date_time);
@@ -32,14 +35,14 @@ protected:
     QTimeEdit* time_edit_;
 };
 
-class DatePicker : public DateTimePicker
+class DATETIMEEDIT_EXPORT DatePicker : public DateTimePicker
 {
     Q_OBJECT
 public:
     DatePicker(QWidget* parent, int year = QDate::currentDate().year(), int month = QDate::currentDate().month());
 };
 
-class DateTimeRangePicker : public QWidget
+class DATETIMEEDIT_EXPORT DateTimeRangePicker : public QWidget
 {
     Q_OBJECT
 public:
@@ -55,6 +58,9 @@ public:
     void dateRange(QDate& start_date, QDate& end_date);
     QPair<QDate, QDate> dateRange();
 
+    void setDateLimits(const QDate& min_date, const QDate& max_date);
+    void setSpecialDate(const QList<QDate>& dates);
+
 signals:
     void timeRangeChanged();
     void dateRangeChanged();
@@ -85,14 +91,14 @@ protected:
     // QList<QDate> selected_dates_;// ֻ֤
 };
 
-class DateRangePicker : public DateTimeRangePicker
+class DATETIMEEDIT_EXPORT DateRangePicker : public DateTimeRangePicker
 {
     Q_OBJECT
 public:
     DateRangePicker(QWidget* parent, int year = QDate::currentDate().year(), int month = QDate::currentDate().month());
 };
 
-class SimpleDateTimeEdit : public QDateTimeEdit
+class DATETIMEEDIT_EXPORT SimpleDateTimeEdit : public QDateTimeEdit
 {
     Q_OBJECT
 public:
@@ -0,0 +1,46 @@
+#ifndef DAYCHANGENOTIFIER_H_
+#define DAYCHANGENOTIFIER_H_
+
+#include <QDateTime>
+#include <QObject>
+#include <QTimer>
+#include <functional>
+
+#include "datetimeedit_global.h"
+
+/**
+ * @brief Ψһڱ仯֪ͨڣʱ֪ͨ
+ * ֻʹһʱ, 󴥷, ÿӸһ; ߻ѡ޸ϵͳʱҲܼʱڱ仯
+ * GUI߳ʹ
+ */
+class DATETIMEEDIT_EXPORT DayChangeNotifier : public QObject
+{
+    Q_OBJECT
+public:
+    using Clock = std::function<QDateTime()>;
+
+    static DayChangeNotifier* Instance();
+
+    QDate today() const { return today_; }
+
+    // 滻ʱ, ڲԼܲģ; պָϵͳʱ, 滻
+    void setClock(const Clock& clock);
+    // , ڱ仯ʱdayChanged
+    void check();
+
+signals:
+    void dayChanged(const QDate& old_day, const QDate& new_day);
+
+private:
+    explicit DayChangeNotifier(QObject* parent);
+
+    QDateTime now() const { return clock_ ? clock_() : QDateTime::currentDateTime(); }
+    void schedule(const QDateTime& now);
+
+private:
+    Clock clock_;
+    QDate today_;
+    QTimer* timer_;
+};
+
+#endif // DAYCHANGENOTIFIER_H_
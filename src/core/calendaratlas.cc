@@ -0,0 +1,166 @@
+#include "calendaratlas.h"
+
+#include <QPaintDevice>
+
+#include "styleresourcepool.h"
+
+constexpr int CalendarAtlas::kMaxEntries;
+constexpr int CalendarAtlas::kHeatLevels;
+
+uint qHash(const CalendarAtlas::GlyphKey& key, uint seed)
+{
+    return qHash(key.font_key, seed) ^ qHash(key.color, seed) ^ qHash(key.dpr_percent, seed);
+}
+
+uint qHash(const CalendarAtlas::SpriteKey& key, uint seed)
+{
+    return qHash((quint64(key.width) << 32) | quint64(key.height), seed) ^ qHash(key.color, seed)
+           ^ qHash(key.dpr_percent * 2 + int(key.outlined), seed);
+}
+
+static int dprPercent(QPainter* painter)
+{
+    return qRound(painter->device()->devicePixelRatioF() * 100);
+}
+
+CalendarAtlas::CalendarAtlas()
+    : last_glyphs_(nullptr)
+    , last_color_(0)
+    , last_dpr_percent_(0)
+    , heat_palette_serial_(0)
+    , heat_ready_(false)
+{}
+
+CalendarAtlas* CalendarAtlas::Instance()
+{
+    static CalendarAtlas obj;
+    return &obj;
+}
+
+void CalendarAtlas::drawDay(QPainter* painter, const QRect& rect, int day, const QColor& color)
+{
+    if (day < 1 || day > 31)
+        return;
+
+    qreal dpr = painter->device()->devicePixelRatioF();
+    DayGlyphs* glyphs = dayGlyphs(painter->font(), color, dpr);
+
+    QPixmap& pixmap = glyphs->pixmaps[day];
+    if (pixmap.isNull())
+        pixmap = renderDay(*glyphs, day, dpr);
+
+    // drawTextһ°ض, ͼֵģ
+    QSize size = (QSizeF(pixmap.size()) / pixmap.devicePixelRatioF()).toSize();
+    painter->drawPixmap(rect.x() + (rect.width() - size.width()) / 2, rect.y() + (rect.height() - size.height()) / 2,
+                        pixmap);
+}
+
+void CalendarAtlas::drawEllipse(QPainter* painter, const QRect& rect, const QColor& color, bool outlined)
+{
+    if (rect.isEmpty())
+        return;
+
+    SpriteKey key{rect.width(), rect.height(), color.rgba(), dprPercent(painter), outlined};
+    auto it = sprites_.constFind(key);
+    if (it == sprites_.constEnd()) {
+        if (sprites_.size() >= kMaxEntries)
+            sprites_.clear();
+        it = sprites_.insert(key, renderEllipse(key));
+    }
+
+    // ߻ᳬrect, λͼܸ1
+    painter->drawPixmap(rect.topLeft() - QPoint(1, 1), it.value());
+}
+
+const QColor& CalendarAtlas::heatColor(int level)
+{
+    quint32 palette_serial = StyleResourcePool::Instance()->PaletteSerial();
+    if (!heat_ready_ || heat_palette_serial_ != palette_serial) {
+        // ͸40ӵ220
+        QColor color = GET_COLOR(StyleResourcePool::kMainColor);
+        heat_colors_[0] = Qt::transparent;
+        for (int i = 1; i < kHeatLevels; ++i) {
+            color.setAlpha(40 + 180 * (i - 1) / (kHeatLevels - 2));
+            heat_colors_[i] = color;
+        }
+
+        heat_palette_serial_ = palette_serial;
+        heat_ready_ = true;
+    }
+
+    return heat_colors_[qBound(0, level, kHeatLevels - 1)];
+}
+
+void CalendarAtlas::clear()
+{
+    qDeleteAll(glyphs_);
+    glyphs_.clear();
+    sprites_.clear();
+    last_glyphs_ = nullptr;
+}
+
+CalendarAtlas::DayGlyphs* CalendarAtlas::dayGlyphs(const QFont& font, const QColor& color, qreal dpr)
+{
+    int dpr_percent = qRound(dpr * 100);
+    if (last_glyphs_ && last_color_ == color.rgba() && last_dpr_percent_ == dpr_percent && last_font_ == font)
+        return last_glyphs_;
+
+    GlyphKey key{font.key(), color.rgba(), dpr_percent};
+    DayGlyphs* glyphs = glyphs_.value(key);
+    if (!glyphs) {
+        if (glyphs_.size() >= kMaxEntries)
+            clear();
+
+        glyphs = new DayGlyphs;
+        glyphs->font = font;
+        glyphs->color = color;
+        glyphs_.insert(key, glyphs);
+    }
+
+    last_glyphs_ = glyphs;
+    last_font_ = font;
+    last_color_ = color.rgba();
+    last_dpr_percent_ = dpr_percent;
+    return glyphs;
+}
+
+QPixmap CalendarAtlas::renderDay(const DayGlyphs& glyphs, int day, qreal dpr)
+{
+    QString text = QString::number(day);
+    QFontMetrics fm(glyphs.font);
+    QSize size(fm.horizontalAdvance(text), fm.height());
+
+    QPixmap pixmap(size * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter(&pixmap);
+    painter.setFont(glyphs.font);
+    painter.setPen(glyphs.color);
+    painter.drawText(QRect(QPoint(0, 0), size), Qt::AlignCenter, text);
+
+    return pixmap;
+}
+
+QPixmap CalendarAtlas::renderEllipse(const SpriteKey& key)
+{
+    qreal dpr = key.dpr_percent / 100.0;
+    QSize size(key.width + 2, key.height + 2);
+
+    QPixmap pixmap(size * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    pixmap.fill(Qt::transparent);
+
+    QColor color = QColor::fromRgba(key.color);
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setBrush(color);
+    if (key.outlined) {
+        painter.setPen(color);
+    } else {
+        painter.setPen(Qt::NoPen);
+    }
+    painter.drawEllipse(QRect(1, 1, key.width, key.height));
+
+    return pixmap;
+}
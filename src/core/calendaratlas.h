@@ -0,0 +1,91 @@
+#ifndef CALENDARATLAS_H_
+#define CALENDARATLAS_H_
+
+#include <QFont>
+#include <QHash>
+#include <QPainter>
+#include <QPixmap>
+
+/**
+ * @brief ƻ棬(, ɫ, 豸ر)ԲεԤȾλͼ, ʱֱͼ
+ * , GUI߳ʹ
+ */
+class CalendarAtlas
+{
+public:
+    static CalendarAtlas* Instance();
+
+    // rectھл(1-31), QPainter::drawText(rect, Qt::AlignCenter, ...)һ
+    void drawDay(QPainter* painter, const QRect& rect, int day, const QColor& color);
+    // Բ, outlinedΪtrueʱͬʱͬɫ
+    void drawEllipse(QPainter* painter, const QRect& rect, const QColor& color, bool outlined = false);
+
+    static constexpr int kHeatLevels = 16;
+    // ͼɫ, levelΪ1 ~ kHeatLevels - 1(0Ϊ͸), ɫ͸Ƚ, 滻ɫ¼
+    const QColor& heatColor(int level);
+
+    void clear();
+
+private:
+    Q_DISABLE_COPY(CalendarAtlas)
+    CalendarAtlas();
+
+    struct DayGlyphs
+    {
+        QFont font;
+        QColor color;
+        QPixmap pixmaps[32];
+    };
+
+    struct GlyphKey
+    {
+        QString font_key;
+        QRgb color;
+        int dpr_percent;
+
+        bool operator==(const GlyphKey& other) const
+        {
+            return color == other.color && dpr_percent == other.dpr_percent && font_key == other.font_key;
+        }
+    };
+
+    struct SpriteKey
+    {
+        int width;
+        int height;
+        QRgb color;
+        int dpr_percent;
+        bool outlined;
+
+        bool operator==(const SpriteKey& other) const
+        {
+            return width == other.width && height == other.height && color == other.color
+                   && dpr_percent == other.dpr_percent && outlined == other.outlined;
+        }
+    };
+
+    friend uint qHash(const GlyphKey& key, uint seed);
+    friend uint qHash(const SpriteKey& key, uint seed);
+
+    DayGlyphs* dayGlyphs(const QFont& font, const QColor& color, qreal dpr);
+    static QPixmap renderDay(const DayGlyphs& glyphs, int day, qreal dpr);
+    static QPixmap renderEllipse(const SpriteKey& key);
+
+private:
+    static constexpr int kMaxEntries = 256;
+
+    QHash<GlyphKey, DayGlyphs*> glyphs_;
+    QHash<SpriteKey, QPixmap> sprites_;
+
+    // ƵĵԪͨʹͬɫ, һεĲѯ
+    DayGlyphs* last_glyphs_;
+    QFont last_font_;
+    QRgb last_color_;
+    int last_dpr_percent_;
+
+    QColor heat_colors_[kHeatLevels];
+    quint32 heat_palette_serial_;
+    bool heat_ready_;
+};
+
+#endif // CALENDARATLAS_H_
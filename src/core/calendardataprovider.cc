@@ -0,0 +1,12 @@
+#include "calendardataprovider.h"
+
+#include <QFutureInterface>
+
+QFuture<QList<QDate>> CalendarDataProvider::readyResult(const QList<QDate>& dates)
+{
+    QFutureInterface<QList<QDate>> result;
+    result.reportStarted();
+    result.reportResult(dates);
+    result.reportFinished();
+    return result.future();
+}
@@ -0,0 +1,67 @@
+#include "calendargrid.h"
+
+constexpr int CalendarGridCache::kCapacity;
+
+CalendarGridCache::CalendarGridCache()
+    : tick_(0)
+{
+    for (int i = 0; i < kCapacity; ++i) {
+        grids_[i].year = 0;
+        grids_[i].month = 0;
+        grids_[i].first_day_on_week = 0;
+        last_used_[i] = 0;
+    }
+}
+
+CalendarGridCache* CalendarGridCache::Instance()
+{
+    static CalendarGridCache obj;
+    return &obj;
+}
+
+CalendarGrid CalendarGridCache::compute(int year, int month, int first_day_on_week)
+{
+    CalendarGrid grid;
+    grid.year = year;
+    grid.month = month;
+    grid.first_day_on_week = first_day_on_week;
+
+    qint64 first_day = CalendarMath::julianDay(year, month, 1);
+    grid.lead_days = CalendarMath::leadDays(CalendarMath::dayOfWeek(first_day), first_day_on_week);
+    grid.month_days = CalendarMath::daysInMonth(year, month);
+    grid.first_julian_day = first_day - grid.lead_days;
+
+    int pre_month_days = month == 1 ? 31 : CalendarMath::daysInMonth(year, month - 1);
+    int day = pre_month_days - grid.lead_days + 1;
+    int month_end = pre_month_days;
+    for (int i = 0; i < CalendarMath::kGridCells; ++i) {
+        if (day > month_end) {
+            day = 1;
+            month_end = (i == grid.lead_days) ? grid.month_days : 31;
+        }
+        grid.days[i] = quint8(day++);
+    }
+
+    return grid;
+}
+
+CalendarGrid CalendarGridCache::grid(int year, int month, int first_day_on_week)
+{
+    ++tick_;
+
+    int lru = 0;
+    for (int i = 0; i < kCapacity; ++i) {
+        const CalendarGrid& cached = grids_[i];
+        if (cached.year == year && cached.month == month && cached.first_day_on_week == first_day_on_week) {
+            last_used_[i] = tick_;
+            return cached;
+        }
+
+        if (last_used_[i] < last_used_[lru])
+            lru = i;
+    }
+
+    grids_[lru] = compute(year, month, first_day_on_week);
+    last_used_[lru] = tick_;
+    return grids_[lru];
+}
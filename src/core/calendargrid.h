@@ -0,0 +1,149 @@
+#ifndef CALENDARGRID_H_
+#define CALENDARGRID_H_
+
+#include <QtGlobal>
+
+/**
+ * @brief 㣬(QDate::toJulianDayһ)ֱӼ㣬QDate::addDays
+ */
+namespace CalendarMath {
+
+constexpr int kDaysInWeek = 7;
+constexpr int kGridRows = 6;
+constexpr int kGridCells = kDaysInWeek * kGridRows;
+
+constexpr bool isLeapYear(int year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+constexpr int daysInMonth(int year, int month)
+{
+    return month == 2 ? (isLeapYear(year) ? 29 : 28) : (month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+}
+
+// Ϊꡢ, ռ
+constexpr qint64 shiftedYear(int year, int month)
+{
+    return qint64(year) + 4800 - (14 - month) / 12;
+}
+
+constexpr qint64 shiftedMonth(int month)
+{
+    return month + 12 * ((14 - month) / 12) - 3;
+}
+
+constexpr qint64 julianDayFromShifted(qint64 y, qint64 m, int day)
+{
+    return day + (153 * m + 2) / 5 + 365 * y + y / 4 - y / 100 + y / 400 - 32045;
+}
+
+constexpr qint64 julianDay(int year, int month, int day)
+{
+    return julianDayFromShifted(shiftedYear(year, month), shiftedMonth(month), day);
+}
+
+// 1 = Monday ... 7 = Sunday, same as QDate::dayOfWeek
+constexpr int dayOfWeek(qint64 julian_day)
+{
+    return julian_day >= 0 ? int(julian_day % 7) + 1 : int((((julian_day + 1) % 7) + 6) % 7) + 1;
+}
+
+constexpr int floorDiv(int value, int divisor)
+{
+    return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+}
+
+// Ϊλţ±Ƚ뷭ҳ
+constexpr int monthIndex(int year, int month)
+{
+    return year * 12 + month - 1;
+}
+
+constexpr int yearOfMonthIndex(int month_index)
+{
+    return floorDiv(month_index, 12);
+}
+
+constexpr int monthOfMonthIndex(int month_index)
+{
+    return month_index - floorDiv(month_index, 12) * 12 + 1;
+}
+
+// valueķҳʼֵ, ҳanchorΪ׼, ÿҳpage_size
+constexpr int pageStart(int value, int anchor, int page_size)
+{
+    return anchor + floorDiv(value - anchor, page_size) * page_size;
+}
+
+// (0, 0)֮ǰҪ, µһΪһܵһʱһ
+constexpr int leadDays(int first_day_of_month, int first_day_on_week)
+{
+    return first_day_of_month - first_day_on_week > 0 ? first_day_of_month - first_day_on_week
+                                                       : first_day_of_month - first_day_on_week + kDaysInWeek;
+}
+
+// תΪ, julianDay()(費С0)
+inline void civilFromJulianDay(qint64 julian_day, int* year, int* month, int* day)
+{
+    qint64 a = julian_day + 32044;
+    qint64 b = (4 * a + 3) / 146097;
+    qint64 c = a - 146097 * b / 4;
+    qint64 d = (4 * c + 3) / 1461;
+    qint64 e = c - 1461 * d / 4;
+    qint64 m = (5 * e + 2) / 153;
+
+    *day = int(e - (153 * m + 2) / 5 + 1);
+    *month = int(m + 3 - 12 * (m / 10));
+    *year = int(100 * b + d - 4800 + m / 10);
+}
+
+static_assert(julianDay(1970, 1, 1) == 2440588, "julian day of unix epoch");
+static_assert(dayOfWeek(julianDay(2024, 3, 2)) == 6, "2024-03-02 is Saturday");
+static_assert(daysInMonth(2000, 2) == 29 && daysInMonth(1900, 2) == 28, "leap years");
+static_assert(monthOfMonthIndex(monthIndex(2024, 12)) == 12 && yearOfMonthIndex(monthIndex(2024, 12)) == 2024,
+              "month index round trip");
+
+} // namespace CalendarMath
+
+/**
+ * @brief һҳ(6x7)ļ
+ */
+struct CalendarGrid
+{
+    int year;
+    int month;
+    int first_day_on_week;
+    qint64 first_julian_day; // (0, 0)
+    int lead_days;
+    int month_days;
+    quint8 days[CalendarMath::kGridCells];
+
+    qint64 julianDay(int i) const { return first_julian_day + i; }
+    bool inMonth(int i) const { return i >= lead_days && i < lead_days + month_days; }
+};
+
+/**
+ * @brief (, , ÿܵһ)ʹõҳ, GUI߳ʹ
+ */
+class CalendarGridCache
+{
+public:
+    static CalendarGridCache* Instance();
+
+    static CalendarGrid compute(int year, int month, int first_day_on_week);
+    CalendarGrid grid(int year, int month, int first_day_on_week);
+
+private:
+    Q_DISABLE_COPY(CalendarGridCache)
+    CalendarGridCache();
+
+private:
+    static constexpr int kCapacity = 8;
+
+    CalendarGrid grids_[kCapacity];
+    quint32 last_used_[kCapacity];
+    quint32 tick_;
+};
+
+#endif // CALENDARGRID_H_
@@ -1,11 +1,45 @@
 #include "calendartable.h"
 
-#include "flowlayout.h"
+#include <QApplication>
+#include <QHeaderView>
+#include <QMetaMethod>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QWindow>
+
+#include "calendaratlas.h"
+#include "calendargrid.h"
+#include "daychangenotifier.h"
 #include "styleresourcepool.h"
 
 constexpr int kDaysInWeek = 7;
 constexpr int kPointRadius = 1;
-constexpr int kCalendarRows = 6;
+constexpr int kWheelStep = 120;          // һangleDelta
+constexpr int kWheelPixelsPerMonth = 60; // ذطһ
+constexpr int kWheelFrameInterval = 16;
+constexpr int kMaxPendingMonths = 3; // ٹʱѹ, ͣºҳ
+constexpr int kProviderCacheMonths = 24;
+constexpr int kProviderPrefetchMonths = 2; // Ԥȡǰ, ҳʾϡ¶Ѿ
+constexpr int kGridMargin = 9;       // ꡢѡҳı߾༰ѡߴ
+constexpr int kGridSpacing = 4;
+constexpr int kGridRowSpacing = 20;
+constexpr int kGridItemHeight = 24;
+
+// Inverse of QHeaderView's stretch layout: every section gets length / count pixels and the
+// first (length % count) sections one more.
+static int stretchSectionAt(int pos, int length, int count)
+{
+    if (pos < 0 || pos >= length || count <= 0)
+        return -1;
+
+    int size = length / count;
+    int remainder = length % count;
+    int wide_length = (size + 1) * remainder;
+    if (pos < wide_length)
+        return pos / (size + 1);
+
+    return size > 0 ? qMin(remainder + (pos - wide_length) / size, count - 1) : -1;
+}
 
 DrawBaseDelegate::DrawBaseDelegate(QObject* parent)
     : QStyledItemDelegate(parent)
@@ -61,6 +95,8 @@ void DrawBaseDelegate::drawPoint(QPainter* painter, const QRect& rect, const QCo
 CalendarDelegate::CalendarDelegate(QAbstractItemView* parent)
     : DrawBaseDelegate(parent)
     , parent_view_(parent)
+    , hover_visible_(true)
+    , perf_counters_(nullptr)
 {
     parent_view_->viewport()->installEventFilter(this);
     parent_view_->viewport()->setAttribute(Qt::WA_Hover);
@@ -68,37 +104,70 @@ CalendarDelegate::CalendarDelegate(QAbstractItemView* parent)
 
 void CalendarDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
 {
-    QVariant alpha_data = index.data(CalendarTable::kAlpha);
-    double color_alpha = alpha_data.canConvert<double>() ? alpha_data.toDouble() : 1.0;
-    if (!(QStyle::State_Enabled & option.state)) {
-        color_alpha *= 0.5;
+    auto model = qobject_cast<const CalendarModel*>(index.model());
+    if (!model)
+        return;
+
+    PERF_SCOPE(perf_counters_, kCellPaint);
+
+    // ÿԪֻȡһ, QVariant
+    const CalendarCellStyle style = model->cell(index).style;
+    const QRect& rect = option.rect;
+    bool enabled = QStyle::State_Enabled & option.state;
+    int alpha = enabled ? style.alpha : (style.alpha + 1) / 2;
+    auto color = [alpha](StyleResourcePool::ColorToken token) {
+        QColor color = GET_COLOR(token);
+        color.setAlpha(alpha);
+        return color;
+    };
+
+    // Day numbers and circles are blitted from pre-rendered pixmaps, shared by all calendars.
+    // The painter is shared by all cells of a frame, so nothing is saved or restored per cell.
+    auto atlas = CalendarAtlas::Instance();
+
+    bool draw_bg = style.hasColor(CalendarCellStyle::kBackground);
+    bool draw_hover = !draw_bg && enabled && hover_visible_ && index == hover_index_
+                      && style.hasColor(CalendarCellStyle::kHover);
+
+    // Χɫͼײ, ѡСڵı
+    if (style.hasColor(CalendarCellStyle::kBand)) {
+        QRect band_rect = rect.adjusted(0, 1, 0, -1);
+        if (style.band == CalendarCellStyle::kBandStart) {
+            band_rect.setLeft(rect.center().x());
+        } else if (style.band == CalendarCellStyle::kBandEnd) {
+            band_rect.setRight(rect.center().x());
+        }
+        painter->fillRect(band_rect, color(style.color(CalendarCellStyle::kBand)));
     }
 
-    QColor tmp_color;
+    if (style.heat > 0) {
+        QColor heat_color = atlas->heatColor(style.heat);
+        heat_color.setAlpha(heat_color.alpha() * alpha / 255);
+        painter->fillRect(rect.adjusted(2, 2, -2, -2), heat_color);
+    }
 
-    bool draw_bg = colorByRole(index, CalendarTable::kBgColor, color_alpha, tmp_color);
     if (draw_bg) {
-        drawBackgroud(painter, option.rect, tmp_color);
+        atlas->drawEllipse(painter, rect.adjusted(1, 1, -1, -1), color(style.color(CalendarCellStyle::kBackground)));
     }
 
-    if (colorByRole(index, CalendarTable::kBorderColor, color_alpha, tmp_color)) {
-        drawBorder(painter, option.rect, tmp_color);
+    if (style.hasColor(CalendarCellStyle::kBorder)) {
+        painter->setPen(color(style.color(CalendarCellStyle::kBorder)));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRect(rect.x(), rect.y(), rect.width() - 1, rect.height() - 1);
     }
 
-    if (colorByRole(index, CalendarTable::kHoverBorderColor, color_alpha, tmp_color)) {
-        if (!draw_bg && index == hover_index_ && (QStyle::State_Enabled & option.state)) {
-            drawBackgroud(painter, option.rect, tmp_color);
-        }
+    if (draw_hover) {
+        atlas->drawEllipse(painter, rect.adjusted(1, 1, -1, -1), color(style.color(CalendarCellStyle::kHover)));
     }
 
-    if (colorByRole(index, CalendarTable::kFontColor, color_alpha, tmp_color)) {
-        drawText(painter, option.rect, tmp_color, index.data().toString());
+    if (style.hasColor(CalendarCellStyle::kText)) {
+        atlas->drawDay(painter, rect, style.day, color(style.color(CalendarCellStyle::kText)));
     }
 
-    if (colorByRole(index, CalendarTable::kPointColor, color_alpha, tmp_color)) {
-        QRect tmp_rect(option.rect.x() + option.rect.width() / 2 - kPointRadius,
-                       option.rect.y() + option.rect.height() * 6 / 7 - kPointRadius, 2 * kPointRadius, 2 * kPointRadius);
-        drawPoint(painter, tmp_rect, tmp_color);
+    if (style.hasColor(CalendarCellStyle::kPoint)) {
+        QRect tmp_rect(rect.x() + rect.width() / 2 - kPointRadius, rect.y() + rect.height() * 6 / 7 - kPointRadius,
+                       2 * kPointRadius, 2 * kPointRadius);
+        atlas->drawEllipse(painter, tmp_rect, color(style.color(CalendarCellStyle::kPoint)), true);
     }
 
     // QStyledItemDelegate::paint(painter, option, index);
@@ -107,44 +176,201 @@ void CalendarDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opti
 bool CalendarDelegate::eventFilter(QObject* obj, QEvent* ev)
 {
     if (obj == parent_view_->viewport()) {
-        if (ev->type() == QEvent::HoverMove) {
-            QPoint pos = parent_view_->viewport()->mapFromGlobal(QCursor::pos());
-            hover_index_ = parent_view_->indexAt(pos);
-        } else if (ev->type() == QEvent::Leave) {
-            hover_index_ = QModelIndex();
+        switch (ev->type()) {
+        case QEvent::HoverEnter:
+        case QEvent::HoverMove:
+            setHoverIndex(cellAt(static_cast<QHoverEvent*>(ev)->pos()));
+            break;
+        case QEvent::HoverLeave:
+        case QEvent::Leave:
+            setHoverIndex(QModelIndex());
+            break;
+        default:
+            break;
         }
     }
 
     return DrawBaseDelegate::eventFilter(obj, ev);
 }
 
-bool CalendarDelegate::colorByRole(const QModelIndex& model_index, int role, double alpha, QColor& tmp_color) const
+QModelIndex CalendarDelegate::cellAt(const QPoint& pos) const
+{
+    auto model = parent_view_->model();
+    if (!model)
+        return QModelIndex();
+
+    QSize size = parent_view_->viewport()->size();
+    int row = stretchSectionAt(pos.y(), size.height(), model->rowCount());
+    int column = stretchSectionAt(pos.x(), size.width(), model->columnCount());
+    if (row < 0 || column < 0)
+        return QModelIndex();
+
+    return model->index(row, column);
+}
+
+void CalendarDelegate::setHoverIndex(const QModelIndex& index)
+{
+    if (index == hover_index_)
+        return;
+
+    // Only the cell losing and the cell gaining the hover circle are repainted.
+    auto viewport = parent_view_->viewport();
+    if (hover_index_.isValid())
+        viewport->update(parent_view_->visualRect(hover_index_));
+
+    hover_index_ = index;
+
+    if (hover_index_.isValid())
+        viewport->update(parent_view_->visualRect(hover_index_));
+}
+
+constexpr int CalendarModel::kRows;
+constexpr int CalendarModel::kColumns;
+constexpr int CalendarModel::kCellCount;
+constexpr quint64 CalendarModel::kAllCells;
+
+CalendarModel::CalendarModel(QObject* parent)
+    : QAbstractTableModel(parent)
+    , dirty_cells_(0)
+{
+    for (auto& cell : cells_) {
+        cell.in_month = false;
+        cell.month_index = 0;
+        cell.style = CalendarCellStyle();
+    }
+}
+
+int CalendarModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : kRows;
+}
+
+int CalendarModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : kColumns;
+}
+
+QVariant CalendarModel::data(const QModelIndex& index, int role) const
 {
-    QVariant var = model_index.data(role);
-    if (var.canConvert<QColor>()) {
-        tmp_color = var.value<QColor>();
-        if (alpha) {
-            tmp_color.setAlphaF(alpha);
+    if (!index.isValid())
+        return QVariant();
+
+    const CalendarCellStyle& style = cell(index).style;
+    auto toVariant = [&style](CalendarCellStyle::Part part) {
+        return style.hasColor(part) ? QVariant(GET_COLOR(style.color(part))) : QVariant();
+    };
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return style.day;
+    case Qt::TextAlignmentRole:
+        return int(Qt::AlignCenter);
+    case Qt::SizeHintRole:
+        return QSize(24, 24);
+    case CalendarTable::kDate:
+        return cell(index).date;
+    case CalendarTable::kBgColor:
+        return toVariant(CalendarCellStyle::kBackground);
+    case CalendarTable::kBorderColor:
+        return toVariant(CalendarCellStyle::kBorder);
+    case CalendarTable::kHoverBorderColor:
+        return toVariant(CalendarCellStyle::kHover);
+    case CalendarTable::kFontColor:
+        return toVariant(CalendarCellStyle::kText);
+    case CalendarTable::kPointColor:
+        return toVariant(CalendarCellStyle::kPoint);
+    case CalendarTable::kAlpha:
+        return style.alpha / 255.0;
+    case CalendarTable::kCellStyle:
+        return QVariant::fromValue(style);
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+QVariant CalendarModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < kColumns)
+        return week_labels_[section];
+
+    return QVariant();
+}
+
+void CalendarModel::setWeekLabels(const QStringList& labels)
+{
+    for (int i = 0; i < kColumns && i < labels.size(); ++i) {
+        week_labels_[i] = labels.at(i);
+    }
+    emit headerDataChanged(Qt::Horizontal, 0, kColumns - 1);
+}
+
+void CalendarModel::updateCell(int i, const Cell& cell)
+{
+    if (cells_[i] == cell)
+        return;
+
+    cells_[i] = cell;
+    dirty_cells_ |= quint64(1) << i;
+}
+
+void CalendarModel::flushDirtyCells()
+{
+    if (!dirty_cells_)
+        return;
+
+    if (dirty_cells_ == kAllCells) {
+        dirty_cells_ = 0;
+        emit dataChanged(index(0, 0), index(kRows - 1, kColumns - 1));
+        return;
+    }
+
+    // A single-index dataChanged() makes the view update only that cell's rect.
+    for (int i = 0; i < kCellCount; ++i) {
+        if (dirty_cells_ & (quint64(1) << i)) {
+            QModelIndex cell_index = index(i / kColumns, i % kColumns);
+            emit dataChanged(cell_index, cell_index);
         }
-        return true;
     }
-    return false;
+    dirty_cells_ = 0;
 }
 
 CalendarTable::CalendarTable(QWidget* parent, int year, int month)
-    : QTableWidget(kCalendarRows, kDaysInWeek, parent)
+    : QTableView(parent)
     , year_(year)
     , month_(month)
     , first_day_on_week_(1)
     , max_date_(QDate(year + 100, 1, 1).addDays(-1))
     , min_date_(QDate(year - 100, 1, 1))
+    , max_month_index_(CalendarMath::monthIndex(year + 99, 12))
+    , min_month_index_(CalendarMath::monthIndex(year - 100, 1))
     , is_double_clicked_(false)
+    , band_first_julian_day_(1)
+    , band_last_julian_day_(0)
+    , values_first_julian_day_(0)
+    , values_maximum_(0)
+    , heat_maximum_(0)
+    , data_provider_(nullptr)
+    , provider_masks_(kProviderCacheMonths)
     , select_mode_(kSingleSelection)
+    , click_commit_mode_(kAutoCommit)
+    , month_cache_index_(-1)
+    , month_cache_palette_(0)
+    , wheel_delta_(0)
+    , pending_months_(0)
+    , wheel_momentum_(false)
+    , perf_counters_(nullptr)
 {
+    special_masks_[0] = special_masks_[1] = special_masks_[2] = 0;
+
     setMinimumSize(180, 180);
     setObjectName("calendar_table");
     horizontalHeader()->setObjectName("calendar_table_header");
 
+    model_ = new CalendarModel(this);
+    setModel(model_);
+
     setSelectionMode(QAbstractItemView::NoSelection);
     setEditTriggers(QAbstractItemView::NoEditTriggers);
     horizontalHeader()->setFixedHeight(24);
@@ -162,35 +388,51 @@ CalendarTable::CalendarTable(QWidget* parent, int year, int month)
 
     installEventFilter(this);
 
-    setItemDelegate(new CalendarDelegate(this));
+    wheel_timer_ = new QTimer(this);
+    wheel_timer_->setInterval(kWheelFrameInterval);
+    connect(wheel_timer_, &QTimer::timeout, this, &CalendarTable::stepWheelMonth);
 
-    date_timer_ = new QTimer(this);
-    connect(date_timer_, &QTimer::timeout, this, &CalendarTable::refreshTodayDate);
+#ifdef DATETIMEEDIT_PROFILING
+    perf_counters_ = new PerfCounters;
+#endif
+    auto delegate = new CalendarDelegate(this);
+    delegate->setPerfCounters(perf_counters_);
+    setItemDelegate(delegate);
 
-    startRefreshTimer();
+    // һڱ仯֪ͨ, ʱֻˢ¾""Ԫ
+    connect(DayChangeNotifier::Instance(), &DayChangeNotifier::dayChanged, this, &CalendarTable::todayChanged);
 
     refreshCalendar();
     refreshCalendarHeader();
 
     setContentsMargins(0, 0, 0, 0);
 
-    connect(this, &QTableWidget::itemClicked, this, &CalendarTable::itemClicked);
-    connect(this, &QTableWidget::itemDoubleClicked, this, &CalendarTable::itemDoubleClicked);
+    connect(this, &QAbstractItemView::clicked, this, &CalendarTable::itemClicked);
+    connect(this, &QAbstractItemView::doubleClicked, this, &CalendarTable::itemDoubleClicked);
+}
+
+CalendarTable::~CalendarTable()
+{
+#ifdef DATETIMEEDIT_PROFILING
+    delete perf_counters_;
+#endif
 }
 
 bool CalendarTable::setYearMonth(int year, int month)
 {
-    year += (month - 1 + 12) / 12 - 1;
-    month = (month - 1 + 12) % 12 + 1;
+    int month_index = CalendarMath::monthIndex(year, month);
+    year = CalendarMath::yearOfMonthIndex(month_index);
 
-    if (year > max_date_.year() || year < min_date_.year()) {
+    if (year > CalendarMath::yearOfMonthIndex(max_month_index_)
+        || year < CalendarMath::yearOfMonthIndex(min_month_index_)) {
         return false;
-    } else if (QDate(year, month, 1) > QDate(max_date_.year(), max_date_.month(), 1)) {
-        month = max_date_.month();
-    } else if (QDate(year, month, 1) < QDate(min_date_.year(), min_date_.month(), 1)) {
-        month = min_date_.month();
+    } else if (month_index > max_month_index_) {
+        month_index = max_month_index_;
+    } else if (month_index < min_month_index_) {
+        month_index = min_month_index_;
     }
 
+    month = CalendarMath::monthOfMonthIndex(month_index);
     if (year_ == year && month_ == month)
         return false;
 
@@ -198,13 +440,19 @@ bool CalendarTable::setYearMonth(int year, int month)
     month_ = month;
 
     refreshCalendar();
+    requestProviderData();
     return true;
 }
 
 void CalendarTable::setFristDayOnWeek(int first_day_on_week)
 {
+    if (first_day_on_week < Qt::Monday || first_day_on_week > Qt::Sunday || first_day_on_week_ == first_day_on_week)
+        return;
+
     first_day_on_week_ = first_day_on_week;
+    invalidateMonthCache();
     refreshCalendarHeader();
+    refreshCalendar();
 }
 
 void CalendarTable::setSelMode(CalendarTable::CalendarSelectionMode select_mode)
@@ -215,10 +463,34 @@ void CalendarTable::setSelMode(CalendarTable::CalendarSelectionMode select_mode)
 
 void CalendarTable::setSpecialDate(const QList<QDate>& dates)
 {
-    special_dates_ = dates;
+    special_dates_.set(dates);
+    invalidateMonthCache();
     refreshSpecialDate();
 }
 
+void CalendarTable::addSpecialDates(const QList<QDate>& dates)
+{
+    if (special_dates_.add(dates)) {
+        invalidateMonthCache();
+        refreshVisibleSpecialDate();
+    }
+}
+
+void CalendarTable::removeSpecialDates(const QList<QDate>& dates)
+{
+    if (special_dates_.remove(dates)) {
+        invalidateMonthCache();
+        refreshVisibleSpecialDate();
+    }
+}
+
+void CalendarTable::setSpecialDateRange(const QDate& start_date, const QDate& end_date)
+{
+    special_dates_.setRange(start_date, end_date);
+    invalidateMonthCache();
+    refreshVisibleSpecialDate();
+}
+
 void CalendarTable::addSelectedDate(const QDate& date)
 {
     if (appendSelection(date))
@@ -227,7 +499,8 @@ void CalendarTable::addSelectedDate(const QDate& date)
 
 void CalendarTable::deleteSelectedDate(const QDate& date)
 {
-    selected_dates_.removeAll(date);
+    selected_dates_.remove(date);
+    invalidateMonthCache();
     emit selectionChanged();
     refreshSelection();
 }
@@ -235,6 +508,7 @@ void CalendarTable::deleteSelectedDate(const QDate& date)
 void CalendarTable::clearSelectedDate()
 {
     selected_dates_.clear();
+    invalidateMonthCache();
     emit selectionChanged();
     refreshSelection();
 }
@@ -245,9 +519,11 @@ void CalendarTable::setMaxDate(const QDate& date)
         return;
 
     max_date_ = date;
+    max_month_index_ = CalendarMath::monthIndex(date.year(), date.month());
+    invalidateMonthCache();
 
-    if (QDate(year_, month_, max_date_.day()) > max_date_) {
-        setYearMonth(max_date_.year(), max_date_.month());
+    if (CalendarMath::monthIndex(year_, month_) > max_month_index_) {
+        setYearMonth(date.year(), date.month());
     }
 
     emit maxDateChanged(date);
@@ -259,65 +535,399 @@ void CalendarTable::setMinDate(const QDate& date)
         return;
 
     min_date_ = date;
+    min_month_index_ = CalendarMath::monthIndex(date.year(), date.month());
+    invalidateMonthCache();
 
-    if (QDate(year_, month_, min_date_.day()) < min_date_) {
-        setYearMonth(min_date_.year(), min_date_.month());
+    if (CalendarMath::monthIndex(year_, month_) < min_month_index_) {
+        setYearMonth(date.year(), date.month());
     }
 
     emit minDateChanged(date);
 }
 
+bool CalendarTable::hasPreMonth()
+{
+    return CalendarMath::monthIndex(year_, month_) > min_month_index_;
+}
+
+bool CalendarTable::hasNextMonth()
+{
+    return CalendarMath::monthIndex(year_, month_) < max_month_index_;
+}
+
 void CalendarTable::setDateRange(const QDate& start_date, const QDate& end_date)
 {
     selected_dates_.clear();
-    selected_dates_.push_back(start_date);
-    selected_dates_.push_back(end_date);
+    selected_dates_.insert(start_date);
+    selected_dates_.insert(end_date);
+    invalidateMonthCache();
+}
+
+void CalendarTable::setRangeBand(const QDate& start_date, const QDate& end_date)
+{
+    qint64 first_julian_day = 1;
+    qint64 last_julian_day = 0;
+    if (start_date.isValid() && end_date.isValid()) {
+        first_julian_day = qMin(start_date.toJulianDay(), end_date.toJulianDay());
+        last_julian_day = qMax(start_date.toJulianDay(), end_date.toJulianDay());
+    }
+
+    if (band_first_julian_day_ == first_julian_day && band_last_julian_day_ == last_julian_day)
+        return;
+
+    band_first_julian_day_ = first_julian_day;
+    band_last_julian_day_ = last_julian_day;
+
+    invalidateMonthCache();
+    refreshSelection();
+}
+
+void CalendarTable::setDayValues(const QDate& start_date, const std::vector<uint32_t>& values)
+{
+    values_first_julian_day_ = start_date.toJulianDay();
+    day_values_ = start_date.isValid() ? values : std::vector<uint32_t>();
+    values_maximum_ = day_values_.empty() ? 0 : *std::max_element(day_values_.begin(), day_values_.end());
+
+    invalidateMonthCache();
+    refreshSelection();
+}
+
+void CalendarTable::clearDayValues()
+{
+    setDayValues(QDate(), std::vector<uint32_t>());
+}
+
+void CalendarTable::setHeatMaximum(quint32 maximum)
+{
+    if (heat_maximum_ == maximum)
+        return;
+
+    heat_maximum_ = maximum;
+    invalidateMonthCache();
+    refreshSelection();
+}
+
+quint32 CalendarTable::dayValue(const QDate& date) const
+{
+    qint64 i = date.toJulianDay() - values_first_julian_day_;
+    if (!date.isValid() || i < 0 || i >= qint64(day_values_.size()))
+        return 0;
+
+    return day_values_[size_t(i)];
+}
+
+quint8 CalendarTable::heatLevel(qint64 julian_day) const
+{
+    qint64 i = julian_day - values_first_julian_day_;
+    if (i < 0 || i >= qint64(day_values_.size()))
+        return 0;
+
+    quint32 maximum = heat_maximum_ ? heat_maximum_ : values_maximum_;
+    quint32 value = qMin(day_values_[size_t(i)], maximum);
+    if (value == 0)
+        return 0;
+
+    // ȡ, 0ֵΪ1
+    return quint8((quint64(value) * (CalendarAtlas::kHeatLevels - 1) + maximum - 1) / maximum);
+}
+
+void CalendarTable::setDataProvider(CalendarDataProvider* provider)
+{
+    data_provider_ = provider;
+    reloadProviderData();
+}
+
+void CalendarTable::reloadProviderData()
+{
+    for (int month_index : provider_requests_.keys()) {
+        cancelProviderRequest(month_index);
+    }
+    provider_masks_.clear();
+    invalidateMonthCache();
+
+    refreshVisibleSpecialDate();
+    requestProviderData();
+}
+
+void CalendarTable::requestProviderData()
+{
+    if (!data_provider_)
+        return;
+
+    int month_index = CalendarMath::monthIndex(year_, month_);
+    int first_month_index = qMax(month_index - kProviderPrefetchMonths, min_month_index_ - 1);
+    int last_month_index = qMin(month_index + kProviderPrefetchMonths, max_month_index_ + 1);
+
+    // ûҳҪ
+    for (int index : provider_requests_.keys()) {
+        if (index < first_month_index || index > last_month_index)
+            cancelProviderRequest(index);
+    }
+
+    // ɽԶ(ƫ0, -1, 1, -2, 2...), ȱ֤ǰʾ·
+    for (int i = 0; i <= kProviderPrefetchMonths * 2; ++i) {
+        int index = month_index + ((i & 1) ? -(i + 1) / 2 : i / 2);
+        if (index < first_month_index || index > last_month_index || provider_masks_.contains(index)
+            || provider_requests_.contains(index)) {
+            continue;
+        }
+
+        QFuture<QList<QDate>> future = data_provider_->fetchMonth(CalendarMath::yearOfMonthIndex(index),
+                                                                  CalendarMath::monthOfMonthIndex(index));
+        if (future.isFinished()) {
+            providerDataArrived(index, future);
+            continue;
+        }
+
+        auto watcher = new DatesWatcher(this);
+        connect(watcher, &DatesWatcher::finished, this, [this, watcher, index]() {
+            provider_requests_.remove(index);
+            watcher->deleteLater();
+            providerDataArrived(index, watcher->future());
+        });
+        watcher->setFuture(future);
+        provider_requests_.insert(index, watcher);
+    }
+}
+
+void CalendarTable::cancelProviderRequest(int month_index)
+{
+    DatesWatcher* watcher = provider_requests_.take(month_index);
+    if (!watcher)
+        return;
+
+    watcher->disconnect(this);
+    watcher->cancel();
+    watcher->deleteLater();
+}
+
+void CalendarTable::providerDataArrived(int month_index, const QFuture<QList<QDate>>& future)
+{
+    if (future.isCanceled() || future.resultCount() == 0)
+        return;
+
+    quint32 mask = 0;
+    for (const QDate& date : future.result()) {
+        if (date.isValid() && CalendarMath::monthIndex(date.year(), date.month()) == month_index)
+            mask |= quint32(1) << (date.day() - 1);
+    }
+    provider_masks_.insert(month_index, mask);
+
+    // ԤȾ·ݿܰ
+    invalidateMonthCache();
+    refreshVisibleSpecialDate();
+}
+
+void CalendarTable::prefetchAdjacentMonths()
+{
+    if (!isVisible() || isMonthCacheValid())
+        return;
+
+    // ʱл·Ⱦָ, ڼģͶź, ɼı񲻻ػ
+    QSignalBlocker blocker(this);
+    QSignalBlocker model_blocker(model_);
+    auto delegate = qobject_cast<CalendarDelegate*>(itemDelegate());
+    if (delegate)
+        delegate->setHoverVisible(false);
+
+    int month_index = CalendarMath::monthIndex(year_, month_);
+
+    month_cache_[1] = grab();
+    for (int offset : {-1, 1}) {
+        QPixmap& pixmap = month_cache_[offset + 1];
+        pixmap = QPixmap();
+
+        int index = month_index + offset;
+        if (index < min_month_index_ || index > max_month_index_)
+            continue;
+
+        year_ = CalendarMath::yearOfMonthIndex(index);
+        month_ = CalendarMath::monthOfMonthIndex(index);
+        refreshCalendar();
+        pixmap = grab();
+    }
+
+    year_ = CalendarMath::yearOfMonthIndex(month_index);
+    month_ = CalendarMath::monthOfMonthIndex(month_index);
+    refreshCalendar();
+
+    if (delegate)
+        delegate->setHoverVisible(true);
+
+    month_cache_index_ = month_index;
+    month_cache_palette_ = StyleResourcePool::Instance()->PaletteSerial();
+    month_cache_size_ = size();
+}
+
+QPixmap CalendarTable::monthPixmap(int offset)
+{
+    if (offset < -1 || offset > 1 || !isMonthCacheValid())
+        return QPixmap();
+
+    return month_cache_[offset + 1];
+}
+
+void CalendarTable::invalidateMonthCache()
+{
+    if (month_cache_index_ < 0)
+        return;
+
+    month_cache_index_ = -1;
+    if (isVisible())
+        emit monthCacheInvalidated();
+}
+
+bool CalendarTable::isMonthCacheValid() const
+{
+    return month_cache_index_ == CalendarMath::monthIndex(year_, month_)
+           && month_cache_palette_ == StyleResourcePool::Instance()->PaletteSerial() && month_cache_size_ == size();
 }
 
 bool CalendarTable::eventFilter(QObject* obj, QEvent* ev)
 {
     if (obj == this) {
         if (ev->type() == QEvent::Wheel && isEnabled()) {
-            auto wheel_event = static_cast<QWheelEvent*>(ev);
-            if (wheel_event->delta() > 0) { // Զʹʱ
-                setYearMonth(year_, month_ - 1);
-            } else {
-                setYearMonth(year_, month_ + 1);
-            }
+            wheelScrolled(static_cast<QWheelEvent*>(ev));
             ev->accept();
             return true;
         }
 
+        if (ev->type() == QEvent::Hide) {
+            wheel_delta_ = 0;
+            pending_months_ = 0;
+        }
+
         if (ev->type() == QEvent::Show) {
             refreshSelection();
+
+            // лͬűĻ, ԤȾλͼҪ
+            if (auto handle = window()->windowHandle()) {
+                connect(handle, &QWindow::screenChanged, this, &CalendarTable::clearPaintCache, Qt::UniqueConnection);
+            }
         }
     }
     return QWidget::eventFilter(obj, ev);
 }
 
-void CalendarTable::itemClicked(QTableWidgetItem* item)
+void CalendarTable::changeEvent(QEvent* ev)
+{
+    switch (ev->type()) {
+    case QEvent::FontChange:
+    case QEvent::StyleChange:
+    case QEvent::PaletteChange:
+        clearPaintCache();
+        break;
+    default:
+        break;
+    }
+
+    QTableView::changeEvent(ev);
+}
+
+void CalendarTable::clearPaintCache()
+{
+    CalendarAtlas::Instance()->clear();
+    invalidateMonthCache();
+    viewport()->update();
+}
+
+void CalendarTable::wheelScrolled(QWheelEvent* ev)
 {
-    if (!item->data(kDate).canConvert<QDate>())
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+    if (ev->phase() == Qt::ScrollMomentum && !wheel_momentum_)
+        return;
+#endif
+    if (ev->phase() == Qt::ScrollBegin)
+        wheel_delta_ = 0;
+
+    // ߾ȴذṩع, ֻͨнǶ
+    int delta = 0;
+    if (!ev->pixelDelta().isNull()) {
+        QPoint pixel_delta = ev->pixelDelta();
+        delta = (pixel_delta.y() != 0 ? pixel_delta.y() : pixel_delta.x()) * kWheelStep / kWheelPixelsPerMonth;
+    } else {
+        QPoint angle_delta = ev->angleDelta();
+        delta = angle_delta.y() != 0 ? angle_delta.y() : angle_delta.x();
+    }
+    if (delta == 0)
+        return;
+
+    // ʱ֮ǰۼ
+    if (wheel_delta_ != 0 && (wheel_delta_ > 0) != (delta > 0)) {
+        wheel_delta_ = 0;
+        pending_months_ = 0;
+    }
+
+    wheel_delta_ += delta;
+    int steps = wheel_delta_ / kWheelStep;
+    wheel_delta_ -= steps * kWheelStep;
+
+    // Զʹʱ(delta > 0)ʾһ
+    pending_months_ = qBound(-kMaxPendingMonths, pending_months_ - steps, kMaxPendingMonths);
+
+    // ϴηҳѳһ֡ʱҳ, ȴʱ
+    if (pending_months_ != 0 && !wheel_timer_->isActive())
+        stepWheelMonth();
+}
+
+void CalendarTable::stepWheelMonth()
+{
+    if (pending_months_ == 0) {
+        wheel_timer_->stop();
+        return;
+    }
+
+    int step = pending_months_ > 0 ? 1 : -1;
+    pending_months_ -= step;
+    if (!setYearMonth(year_, month_ + step))
+        pending_months_ = 0;
+
+    if (!wheel_timer_->isActive())
+        wheel_timer_->start();
+}
+
+void CalendarTable::itemClicked(const QModelIndex& index)
+{
+    if (!index.isValid())
         return;
 
     // doubleClickedEvent: clicked -> doubleClicked -> clicked
     if (!is_double_clicked_) {
-        cliked_date_ = item->data(kDate).value<QDate>();
-        // use QApplication::doubleClickInterval(). The delay is too high, affecting the processing of the click event.
-        QTimer::singleShot(120, this, &CalendarTable::clicked);
+        cliked_date_ = model_->cell(index).date;
+        clicked_index_ = index;
+        if (commitsClickImmediately()) {
+            clicked();
+        } else {
+            // use QApplication::doubleClickInterval(). The delay is too high, affecting the processing of the click event.
+            QTimer::singleShot(120, this, &CalendarTable::clicked);
+        }
     } else {
         is_double_clicked_ = false;
     }
 }
 
-void CalendarTable::itemDoubleClicked(QTableWidgetItem* item)
+bool CalendarTable::commitsClickImmediately() const
+{
+    switch (click_commit_mode_) {
+    case kDeferredCommit:
+        return false;
+    case kSpeculativeCommit:
+        return true;
+    default:
+        // û˫ʱȴ˫
+        return !isSignalConnected(QMetaMethod::fromSignal(&CalendarTable::dateDoubleClicked));
+    }
+}
+
+void CalendarTable::itemDoubleClicked(const QModelIndex& index)
 {
-    if (!item->data(kDate).canConvert<QDate>())
+    if (!index.isValid())
         return;
 
     is_double_clicked_ = true;
 
-    QDate date = item->data(kDate).value<QDate>();
+    // Ч·ʱ, ͬһԪһ, ԵһεΪ׼
+    QDate date = (index == clicked_index_) ? cliked_date_ : model_->cell(index).date;
     if (date > max_date_ || date < min_date_)
         return;
 
@@ -363,36 +973,45 @@ void CalendarTable::clicked()
     }
 }
 
-void CalendarTable::refreshCalendar()
+// Set current date style.
+static void setTodayPoint(CalendarModel::Cell* cell, bool is_today)
 {
-    // Note: һ, (0, 0)
-    QDate cur_date;
-    cur_date.setDate(year_, month_, 1);
-    int fill_days = cur_date.dayOfWeek() - first_day_on_week_;
-    if (fill_days > 0) {
-        cur_date = cur_date.addDays(-fill_days); //ʼ
-    } else {
-        cur_date = cur_date.addDays(-fill_days - 7);
+    if (!is_today) {
+        cell->style.clearColor(CalendarCellStyle::kPoint);
+        return;
+    }
+
+    auto point_color = StyleResourcePool::kMainColor;
+    if (cell->style.hasColor(CalendarCellStyle::kBackground)) {
+        auto bg_color = cell->style.color(CalendarCellStyle::kBackground);
+        if (bg_color == StyleResourcePool::kMainColor || bg_color == StyleResourcePool::kNormalTableItemRange) {
+            point_color = StyleResourcePool::kNormalWhite;
+        }
     }
+    cell->style.setColor(CalendarCellStyle::kPoint, point_color);
+}
+
+void CalendarTable::refreshCalendar()
+{
+    PERF_SCOPE(perf_counters_, kRefreshCalendar);
 
-    // 
-    int max_item_count = columnCount() * rowCount();
-    for (int i = 0; i < max_item_count; ++i) {
-        auto item = new QTableWidgetItem;
-        item->setSizeHint(QSize(24, 24));
-        item->setData(Qt::DisplayRole, cur_date.day());
-        item->setData(kDate, cur_date);
-        item->setTextAlignment(Qt::AlignCenter);
-        item->setData(kFontColor, GET_COLOR("normal_text_font"));
-        item->setData(kHoverBorderColor, GET_COLOR("normal_table_item_range"));
+    // Note: (0, 0)ҳֱӸ, ռ
+    CalendarGrid grid = CalendarGridCache::Instance()->grid(year_, month_, first_day_on_week_);
+    int month_index = CalendarMath::monthIndex(year_, month_);
+
+    // , ԭظµԪ; 弰ԲɫrefreshSelection()ͳһ
+    for (int i = 0; i < CalendarModel::kCellCount; ++i) {
+        CalendarModel::Cell cell = model_->cell(i);
+        cell.date = QDate::fromJulianDay(grid.julianDay(i));
+        cell.in_month = grid.inMonth(i);
+        cell.month_index = cell.in_month ? month_index : (i < grid.lead_days ? month_index - 1 : month_index + 1);
+        cell.style.day = grid.days[i];
+        cell.style.setColor(CalendarCellStyle::kHover, StyleResourcePool::kNormalTableItemRange);
 
         // Ǳʾɫ
-        if (cur_date.month() != month_) {
-            item->setData(kAlpha, 0.2);
-        }
+        cell.style.alpha = cell.in_month ? 255 : 51;
 
-        setItem(i / columnCount(), i % columnCount(), item);
-        cur_date = cur_date.addDays(1);
+        model_->updateCell(i, cell);
     }
 
     refreshSelection();
@@ -408,87 +1027,135 @@ void CalendarTable::refreshCalendarHeader()
     }
 
     QStringList tmp_list;
-    for (int i = 0; i < columnCount(); i++) {
+    for (int i = 0; i < kDaysInWeek; i++) {
         tmp_list << str_list.at((i + first_day_on_week_ - 1) % 7);
     }
-    setHorizontalHeaderLabels(tmp_list);
+    model_->setWeekLabels(tmp_list);
 }
 
 void CalendarTable::refreshSelection()
 {
-    for (int row = 0; row < rowCount(); row++) {
-        for (int col = 0; col < columnCount(); col++) {
-            auto item = this->item(row, col);
-            QDate date = item->data(kDate).value<QDate>();
+    PERF_SCOPE(perf_counters_, kRefreshSelection);
 
-            if (selected_dates_.contains(date)) {
-                QColor bg_color = GET_COLOR("main_color");
-                QString point_color_key =
-                    (date.month() == month_) ? "normal_text_highlight_on_dark_font" : "normal_text_font";
+    loadVisibleSpecialMasks();
 
-                item->setData(kBgColor, bg_color);
-                item->setData(kFontColor, GET_COLOR(point_color_key));
-            } else {
-                QVariant bg_color;
-                if (select_mode_ != kRangeSelection) {
-                    bg_color = special_dates_.contains(date) ? GET_COLOR("normal_table_item_range") : QVariant();
-                }
+    QDate today = DayChangeNotifier::Instance()->today();
+    for (int i = 0; i < CalendarModel::kCellCount; ++i) {
+        CalendarModel::Cell cell = model_->cell(i);
+        const QDate& date = cell.date;
 
-                item->setData(kBgColor, bg_color);
-                item->setData(kFontColor, GET_COLOR("normal_text_font"));
-            }
+        qint64 julian_day = date.toJulianDay();
+        bool in_band = isInRangeBand(julian_day);
+        bool band_endpoint = isRangeBandEndpoint(julian_day);
+
+        if (in_band && band_first_julian_day_ != band_last_julian_day_) {
+            cell.style.setColor(CalendarCellStyle::kBand, StyleResourcePool::kNormalTableItemRange);
+            cell.style.band = julian_day == band_first_julian_day_  ? CalendarCellStyle::kBandStart
+                              : julian_day == band_last_julian_day_ ? CalendarCellStyle::kBandEnd
+                                                                    : CalendarCellStyle::kBandFull;
+        } else {
+            cell.style.clearColor(CalendarCellStyle::kBand);
+            cell.style.band = CalendarCellStyle::kBandFull;
+        }
+
+        if (band_endpoint || selected_dates_.contains(date)) {
+            auto font_color =
+                cell.in_month ? StyleResourcePool::kNormalTextHighlightOnDarkFont : StyleResourcePool::kNormalTextFont;
 
-            // Set current date style.
-            if (date == QDate::currentDate()) {
-                QColor point_color = GET_COLOR("main_color");
-                if (item->data(kBgColor).canConvert<QColor>()) {
-                    auto bg_color = item->data(kBgColor).value<QColor>();
-                    if (bg_color == GET_COLOR("main_color") || bg_color == GET_COLOR("normal_table_item_range")) {
-                        point_color = GET_COLOR("normal_white");
-                    }
-                }
-                item->setData(kPointColor, point_color);
+            cell.style.setColor(CalendarCellStyle::kBackground, StyleResourcePool::kMainColor);
+            cell.style.setColor(CalendarCellStyle::kText, font_color);
+        } else {
+            if (!in_band && select_mode_ != kRangeSelection && isSpecialCell(cell)) {
+                cell.style.setColor(CalendarCellStyle::kBackground, StyleResourcePool::kNormalTableItemRange);
             } else {
-                item->setData(kPointColor, QVariant());
+                cell.style.clearColor(CalendarCellStyle::kBackground);
             }
+            cell.style.setColor(CalendarCellStyle::kText, StyleResourcePool::kNormalTextFont);
         }
+
+        setTodayPoint(&cell, date == today);
+        cell.style.heat = heatLevel(julian_day);
+        model_->updateCell(i, cell);
     }
 
-    update();
+    model_->flushDirtyCells();
 }
 
 void CalendarTable::refreshSpecialDate()
 {
-    for (int row = 0; row < rowCount(); row++) {
-        for (int col = 0; col < columnCount(); col++) {
-            auto item = this->item(row, col);
-            QDate date = item->data(kDate).toDate();
+    PERF_SCOPE(perf_counters_, kRefreshSpecialDate);
 
-            if (!selected_dates_.isEmpty() && date == selected_dates_.at(0)) {
-                item->setData(kBgColor, GET_COLOR("main_color"));
-            } else if (special_dates_.contains(date)) {
-                item->setData(kBgColor, GET_COLOR("normal_table_item_range"));
-            } else {
-                item->setData(kBgColor, QVariant());
-            }
+    loadVisibleSpecialMasks();
+
+    QDate today = DayChangeNotifier::Instance()->today();
+    QDate first_selected_date = selected_dates_.first();
+    for (int i = 0; i < CalendarModel::kCellCount; ++i) {
+        CalendarModel::Cell cell = model_->cell(i);
+        const QDate& date = cell.date;
+
+        qint64 julian_day = date.toJulianDay();
+        if (isRangeBandEndpoint(julian_day) || (first_selected_date.isValid() && date == first_selected_date)) {
+            cell.style.setColor(CalendarCellStyle::kBackground, StyleResourcePool::kMainColor);
+        } else if (!isInRangeBand(julian_day) && isSpecialCell(cell)) {
+            cell.style.setColor(CalendarCellStyle::kBackground, StyleResourcePool::kNormalTableItemRange);
+        } else {
+            cell.style.clearColor(CalendarCellStyle::kBackground);
         }
+        // Բɫ汳仯
+        setTodayPoint(&cell, date == today);
+
+        model_->updateCell(i, cell);
     }
 
-    update();
+    model_->flushDirtyCells();
 }
 
-void CalendarTable::refreshTodayDate()
+void CalendarTable::refreshVisibleSpecialDate()
 {
-    startRefreshTimer();
-    refreshCalendar();
+    // 仯漰ǰʾ·(ǰ·)ʱˢ
+    if (loadVisibleSpecialMasks())
+        refreshSpecialDate();
+}
+
+bool CalendarTable::loadVisibleSpecialMasks()
+{
+    int month_index = CalendarMath::monthIndex(year_, month_);
+
+    bool changed = false;
+    for (int i = 0; i < 3; ++i) {
+        quint32 mask = special_dates_.monthMask(month_index - 1 + i) | provider_masks_.mask(month_index - 1 + i);
+        changed |= (mask != special_masks_[i]);
+        special_masks_[i] = mask;
+    }
+    return changed;
 }
 
-void CalendarTable::startRefreshTimer()
+bool CalendarTable::isSpecialCell(const CalendarModel::Cell& cell) const
 {
-    // ͺ3s
-    auto current_time = QTime::currentTime();
-    int duration = 24 * 3600 - (current_time.hour() * 3600 + current_time.minute() * 60 + current_time.second()) + 3;
-    date_timer_->start(duration * 1000);
+    int offset = cell.month_index - CalendarMath::monthIndex(year_, month_) + 1;
+    if (offset < 0 || offset > 2)
+        return false;
+
+    return special_masks_[offset] & (quint32(1) << (cell.style.day - 1));
+}
+
+void CalendarTable::todayChanged(const QDate& old_day, const QDate& new_day)
+{
+    invalidateMonthCache();
+
+    qint64 first_julian_day = model_->cell(0).date.toJulianDay();
+
+    for (const QDate& day : {old_day, new_day}) {
+        qint64 i = day.toJulianDay() - first_julian_day;
+        if (!day.isValid() || i < 0 || i >= CalendarModel::kCellCount)
+            continue;
+
+        CalendarModel::Cell cell = model_->cell(int(i));
+        setTodayPoint(&cell, day == new_day);
+        model_->updateCell(int(i), cell);
+    }
+
+    model_->flushDirtyCells();
 }
 
 bool CalendarTable::appendSelection(const QDate& date)
@@ -502,20 +1169,21 @@ bool CalendarTable::appendSelection(const QDate& date)
     switch (select_mode_) {
     case kSingleSelection:
         selected_dates_.clear();
-        selected_dates_.append(date);
+        selected_dates_.insert(date);
         break;
     case kMultiSelection:
-        selected_dates_.append(date);
+        selected_dates_.insert(date);
         break;
     case kRangeSelection: {
         selected_dates_.clear();
-        selected_dates_.append(date);
+        selected_dates_.insert(date);
         break;
     }
     default:
         return false;
     }
 
+    invalidateMonthCache();
     emit selectionAdded(date);
     emit selectionChanged();
     return true;
@@ -527,144 +1195,232 @@ bool CalendarTable::removeSelection(const QDate& date)
         return false;
 
     // ѡ֤һһѡ
-    if (select_mode_ == kSingleSelection && selected_dates_.count() <= 1) {
+    if (select_mode_ == kSingleSelection && selected_dates_.size() <= 1) {
         return false;
     }
 
-    selected_dates_.removeAll(date);
+    selected_dates_.remove(date);
+    invalidateMonthCache();
     emit selectionDeleted(date);
 
     return true;
 }
 
-void CalendarButtonGruop::setSelection(int id)
+CalendarItemGrid::CalendarItemGrid(QWidget* parent)
+    : QWidget(parent)
+    , first_id_(0)
+    , selected_id_(-1)
+    , hover_index_(-1)
+    , pressed_index_(-1)
+{
+    setMinimumWidth(212);
+    setMouseTracking(true);
+}
+
+void CalendarItemGrid::setSelection(int id)
 {
-    bool is_find = false;
+    if (selected_id_ == id)
+        return;
 
-    for (int i = 0; i < button_group_.size(); ++i) {
-        auto button = button_group_.at(i);
-        if (button->property("id").toInt() == id) {
-            button->setChecked(true);
-            is_find = true;
-        }
-    }
+    selected_id_ = id;
+    update();
+}
 
-    if (!is_find) {
-        int first_show_in_current_year_page = QDate::currentDate().year() - 6;
-        int show_year = first_show_in_current_year_page;
+QSize CalendarItemGrid::sizeHint() const
+{
+    return QSize(212, kGridMargin * 2 + kRows * kGridItemHeight + (kRows - 1) * kGridRowSpacing);
+}
 
-        if (id >= first_show_in_current_year_page) {
-            int page = (id - first_show_in_current_year_page) / 12;
-            show_year = first_show_in_current_year_page + page * 12;
-        } else {
-            int page = (first_show_in_current_year_page - id) / 12 + 1;
-            show_year = first_show_in_current_year_page - page * 12;
-        }
+void CalendarItemGrid::setFirstId(int first_id)
+{
+    if (first_id_ == first_id)
+        return;
 
-        for (auto button : button_group_) {
-            button->setText(QString::number(show_year));
-            button->setProperty("id", show_year);
+    first_id_ = first_id;
+    update();
+}
 
-            if (button->property("id").toInt() == id)
-                button->setChecked(true);
+QRect CalendarItemGrid::itemRect(int index) const
+{
+    int item_width = (width() - kGridMargin * 2 - (kColumns - 1) * kGridSpacing) / kColumns;
+    int column = index % kColumns;
+    int row = index / kColumns;
 
-            signal_mapper_->setMapping(button, show_year++);
-        }
-    }
+    return QRect(kGridMargin + column * (item_width + kGridSpacing),
+                 kGridMargin + row * (kGridItemHeight + kGridRowSpacing), item_width, kGridItemHeight);
 }
 
-YearButtonGroup::YearButtonGroup(int year, QWidget* parent)
-    : CalendarButtonGruop(parent)
+int CalendarItemGrid::itemAt(const QPoint& pos) const
 {
-    setMinimumWidth(212);
+    int item_width = (width() - kGridMargin * 2 - (kColumns - 1) * kGridSpacing) / kColumns;
+    int x = pos.x() - kGridMargin;
+    int y = pos.y() - kGridMargin;
+    if (x < 0 || y < 0 || item_width <= 0)
+        return -1;
+
+    int column = x / (item_width + kGridSpacing);
+    int row = y / (kGridItemHeight + kGridRowSpacing);
+    if (column >= kColumns || row >= kRows)
+        return -1;
+
+    // ųѡ֮ļ
+    int index = row * kColumns + column;
+    return itemRect(index).contains(pos) ? index : -1;
+}
 
-    auto flow_layout = new FlowLayout(-1, 4, 20);
-    signal_mapper_ = new QSignalMapper(this);
+void CalendarItemGrid::paintEvent(QPaintEvent* ev)
+{
+    QPainter painter(this);
+
+    QFont font = painter.font();
+    font.setPixelSize(12);
+    painter.setFont(font);
+
+    for (int i = 0; i < kItemCount; ++i) {
+        QRect rect = itemRect(i);
+        if (!ev->rect().intersects(rect))
+            continue;
+
+        int id = first_id_ + i;
+        bool enabled = isEnabled() && isItemEnabled(id);
+
+        // ɫȡԵɫ, л(SetPalette)ػ漴Ч
+        QColor text_color = GET_COLOR(StyleResourcePool::kNormalTextFont);
+        if (id == selected_id_) {
+            painter.fillRect(rect, GET_COLOR(StyleResourcePool::kMainColor));
+            text_color = GET_COLOR(StyleResourcePool::kNormalTextHighlightOnDarkFont);
+        } else if (i == hover_index_ && enabled) {
+            painter.fillRect(rect, GET_COLOR(StyleResourcePool::kNormalTableItemRange));
+        }
 
-    for (int i = year - 6; i < year + 6; ++i) {
-        auto button = new QPushButton(QString::number(i), this);
-        button->setObjectName("calendar_btn_year_month");
-        // button->setFixedSize(42, 20);
-        button->setMinimumSize(42, 20);
-        button->setCheckable(true);
-        button->setAutoExclusive(true);
-        button->setProperty("id", i);
-        button_group_.push_back(button);
-        connect(button, SIGNAL(clicked()), signal_mapper_, SLOT(map()));
+        if (!enabled)
+            text_color.setAlphaF(text_color.alphaF() * 0.3);
 
-        signal_mapper_->setMapping(button, i);
-        flow_layout->addWidget(button);
+        painter.setPen(text_color);
+        painter.drawText(rect, Qt::AlignCenter, itemText(id));
     }
-    connect(signal_mapper_, SIGNAL(mapped(int)), this, SIGNAL(yearClicked(int)));
+}
 
-    setLayout(flow_layout);
+void CalendarItemGrid::mouseMoveEvent(QMouseEvent* ev)
+{
+    setHoverIndex(itemAt(ev->pos()));
+    QWidget::mouseMoveEvent(ev);
 }
 
-void YearButtonGroup::toPreYearPage(int current_year)
+void CalendarItemGrid::mousePressEvent(QMouseEvent* ev)
 {
-    int first_show_year = button_group_.at(0)->property("id").toInt();
-    int show_year = first_show_year - 12;
+    if (ev->button() == Qt::LeftButton)
+        pressed_index_ = itemAt(ev->pos());
 
-    refreshYearPage(show_year, current_year);
+    QWidget::mousePressEvent(ev);
 }
 
-void YearButtonGroup::toNextYearPage(int current_year)
+void CalendarItemGrid::mouseReleaseEvent(QMouseEvent* ev)
 {
-    int first_show_year = button_group_.at(0)->property("id").toInt();
-    int show_year = first_show_year + 12;
+    QWidget::mouseReleaseEvent(ev);
+    if (ev->button() != Qt::LeftButton)
+        return;
+
+    // 밴ťһ, ͬһѡϰ²ͷŲ
+    int index = itemAt(ev->pos());
+    int pressed_index = pressed_index_;
+    pressed_index_ = -1;
 
-    refreshYearPage(show_year, current_year);
+    if (index < 0 || index != pressed_index || !isItemEnabled(first_id_ + index))
+        return;
+
+    setSelection(first_id_ + index);
+    itemClicked(first_id_ + index);
 }
 
-void YearButtonGroup::refreshYearPage(int show_year, int current_year)
+void CalendarItemGrid::leaveEvent(QEvent* ev)
 {
-    for (auto button : button_group_) {
-        button->setText(QString::number(show_year));
-        button->setProperty("id", show_year);
-        if (button->property("id").toInt() == current_year) {
-            button->setAutoExclusive(false);
-            button->setChecked(true);
-            button->setAutoExclusive(true);
-        } else {
-            button->setAutoExclusive(false);
-            button->setChecked(false);
-            button->setAutoExclusive(true);
-        }
+    setHoverIndex(-1);
+    QWidget::leaveEvent(ev);
+}
 
-        signal_mapper_->setMapping(button, show_year++);
-    }
+void CalendarItemGrid::setHoverIndex(int index)
+{
+    if (hover_index_ == index)
+        return;
+
+    if (hover_index_ >= 0)
+        update(itemRect(hover_index_));
+    if (index >= 0)
+        update(itemRect(index));
+
+    hover_index_ = index;
 }
 
-MonthButtonGroup::MonthButtonGroup(QWidget* parent)
-    : CalendarButtonGruop(parent)
+YearButtonGroup::YearButtonGroup(int year, QWidget* parent)
+    : CalendarItemGrid(parent)
+    , min_year_(year - 100)
+    , max_year_(year + 99)
+    , wheel_delta_(0)
 {
-    setMinimumWidth(212);
+    setFirstId(year - 6);
+}
 
-    QStringList month_list;
-    for (int i = 1; i <= 12; ++i) {
-        month_list << GET_TXT(QString("IDCS_MONTH_%1").arg(i));
+void YearButtonGroup::setSelection(int year)
+{
+    // ڵǰҳʱתݵҳ, ҳԽҳΪ׼
+    if (year < first_id() || year >= first_id() + kItemCount) {
+        int first_show_in_current_year_page = DayChangeNotifier::Instance()->today().year() - 6;
+        scrollToYear(CalendarMath::pageStart(year, first_show_in_current_year_page, kItemCount));
     }
 
-    auto flow_layout = new FlowLayout(-1, 4, 20);
-    signal_mapper_ = new QSignalMapper(this);
+    CalendarItemGrid::setSelection(year);
+}
 
-    for (int i = 0; i < 12; ++i) {
-        auto button = new QPushButton(month_list.at(i), this);
-        button->setObjectName("calendar_btn_year_month");
-        // button->setFixedSize(42, 20);
-        button->setMinimumSize(42, 20);
-        button->setCheckable(true);
-        button->setAutoExclusive(true);
-        button->setProperty("id", i + 1);
-        button_group_.push_back(button);
-        connect(button, SIGNAL(clicked()), signal_mapper_, SLOT(map()));
+void YearButtonGroup::setYearRange(int min_year, int max_year)
+{
+    min_year_ = min_year;
+    max_year_ = qMax(min_year, max_year);
 
-        signal_mapper_->setMapping(button, i + 1);
-        flow_layout->addWidget(button);
+    scrollToYear(first_id());
+    update();
+}
+
+void YearButtonGroup::toPreYearPage(int current_year)
+{
+    scrollToYear(first_id() - kItemCount);
+    CalendarItemGrid::setSelection(current_year);
+}
+
+void YearButtonGroup::toNextYearPage(int current_year)
+{
+    scrollToYear(first_id() + kItemCount);
+    CalendarItemGrid::setSelection(current_year);
+}
+
+void YearButtonGroup::wheelEvent(QWheelEvent* ev)
+{
+    // ÿһƶһ
+    wheel_delta_ += ev->angleDelta().y();
+    int rows = wheel_delta_ / kWheelStep;
+    wheel_delta_ -= rows * kWheelStep;
+
+    if (rows != 0)
+        scrollToYear(first_id() - rows * kColumns);
+
+    ev->accept();
+}
+
+void YearButtonGroup::scrollToYear(int first_year)
+{
+    // ֤ʾݶڷΧ, ΧһҳʱСݿʼʾ
+    int max_first_year = qMax(min_year_, max_year_ - kItemCount + 1);
+    setFirstId(qBound(min_year_, first_year, max_first_year));
+}
+
+MonthButtonGroup::MonthButtonGroup(QWidget* parent)
+    : CalendarItemGrid(parent)
+{
+    for (int i = 1; i <= kItemCount; ++i) {
+        month_texts_ << GET_TXT(QString("IDCS_MONTH_%1").arg(i));
     }
-    connect(signal_mapper_, SIGNAL(mapped(int)), this, SIGNAL(monthClicked(int)));
 
-    setLayout(flow_layout);
+    setFirstId(1);
 }
 
 #include "moc_calendartable.cpp"
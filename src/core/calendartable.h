@@ -1,18 +1,81 @@
 #ifndef CALENDARTABLE_H_
 #define CALENDARTABLE_H_
 
+#include <QAbstractTableModel>
+#include <QColor>
 #include <QDate>
 #include <QEvent>
+#include <QFutureWatcher>
 #include <QLabel>
 #include <QPushButton>
-#include <QSignalMapper>
 #include <QStackedLayout>
 #include <QStackedWidget>
 #include <QStyledItemDelegate>
-#include <QTableWidget>
+#include <QTableView>
 #include <QTimer>
+#include <QWheelEvent>
+#include <algorithm>
+#include <vector>
 
-class DrawBaseDelegate : public QStyledItemDelegate
+#include "calendardataprovider.h"
+#include "dateset.h"
+#include "datetimeedit_global.h"
+#include "perfcounters.h"
+#include "styleresourcepool.h"
+
+/**
+ * @brief ԪۣҿƽƣʱÿԪֻȡһ
+ * ֻɫɫ, ʱȡɫ, л¼㵥Ԫ
+ */
+struct CalendarCellStyle
+{
+    enum Part
+    {
+        kBackground,
+        kBorder,
+        kHover,
+        kText,
+        kPoint,
+        kBand, // ڷΧɫ, ״band
+        kPartCount
+    };
+
+    enum BandShape
+    {
+        kBandFull,
+        kBandStart, // Χ, ֻҰ벿
+        kBandEnd,   // Χյ, ֻ벿
+    };
+
+    StyleResourcePool::ColorToken colors[kPartCount];
+    quint8 parts; // ҪƵĲ, nλӦPart n
+    quint8 alpha; // 岻͸, 0-255
+    quint8 day;
+    quint8 heat; // ͼȼ, 0ʾ, CalendarAtlas::heatColor
+    quint8 band; // BandShape
+
+    bool hasColor(Part part) const { return parts & (1 << part); }
+    StyleResourcePool::ColorToken color(Part part) const { return colors[part]; }
+    void setColor(Part part, StyleResourcePool::ColorToken token)
+    {
+        colors[part] = token;
+        parts |= (1 << part);
+    }
+    void clearColor(Part part)
+    {
+        colors[part] = StyleResourcePool::ColorToken(0);
+        parts &= ~(1 << part);
+    }
+
+    bool operator==(const CalendarCellStyle& other) const
+    {
+        return parts == other.parts && alpha == other.alpha && day == other.day && heat == other.heat && band == other.band
+               && std::equal(colors, colors + kPartCount, other.colors);
+    }
+};
+Q_DECLARE_METATYPE(CalendarCellStyle)
+
+class DATETIMEEDIT_EXPORT DrawBaseDelegate : public QStyledItemDelegate
 {
     Q_OBJECT
 public:
@@ -26,29 +89,85 @@ protected:
     void drawPoint(QPainter* painter, const QRect& rect, const QColor& color) const;
 };
 
-class CalendarDelegate : public DrawBaseDelegate
+class DATETIMEEDIT_EXPORT CalendarDelegate : public DrawBaseDelegate
 {
     Q_OBJECT
 public:
     CalendarDelegate(QAbstractItemView* parent);
 
+    // ͼʱͣԲȦ, ػ
+    void setHoverVisible(bool visible) { hover_visible_ = visible; }
+
+    void setPerfCounters(PerfCounters* counters) { perf_counters_ = counters; }
+
 protected:
     void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
     bool eventFilter(QObject* obj, QEvent* ev) override;
 
 private:
-    bool colorByRole(const QModelIndex& model_index, int role, double alpha, QColor& tmp_color) const;
+    QModelIndex cellAt(const QPoint& pos) const;
+    void setHoverIndex(const QModelIndex& index);
 
 private:
     QAbstractItemView* parent_view_;
     QModelIndex hover_index_;
+    bool hover_visible_;
+    PerfCounters* perf_counters_;
 };
 
-class CalendarTable : public QTableWidget
+/**
+ * @brief Ԫģ̶ͣ6x7ĵԪ飬ҳʱԭˢ£ظ
+ */
+class DATETIMEEDIT_EXPORT CalendarModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    struct Cell
+    {
+        QDate date;
+        bool in_month;
+        int month_index;
+        CalendarCellStyle style;
+
+        bool operator==(const Cell& other) const { return date == other.date && style == other.style; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    static constexpr int kRows = 6;
+    static constexpr int kColumns = 7;
+    static constexpr int kCellCount = kRows * kColumns;
+
+    explicit CalendarModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    const Cell& cell(int i) const { return cells_[i]; }
+    const Cell& cell(const QModelIndex& index) const { return cells_[index.row() * kColumns + index.column()]; }
+
+    void setWeekLabels(const QStringList& labels);
+
+    // б仯ʱż¼Ϊ൥Ԫ, flushDirtyCells()ʱֻˢЩԪ
+    void updateCell(int i, const Cell& cell);
+    void markAllDirty() { dirty_cells_ = kAllCells; }
+    void flushDirtyCells();
+
+private:
+    static constexpr quint64 kAllCells = (quint64(1) << kCellCount) - 1;
+
+    Cell cells_[kCellCount];
+    QString week_labels_[kColumns];
+    quint64 dirty_cells_;
+};
+
+class DATETIMEEDIT_EXPORT CalendarTable : public QTableView
 {
     Q_OBJECT
 public:
     CalendarTable(QWidget* parent, int year = QDate::currentDate().year(), int month = QDate::currentDate().month());
+    ~CalendarTable() override;
 
     enum CalendarRoleType
     {
@@ -58,7 +177,8 @@ public:
         kHoverBorderColor,
         kFontColor,
         kPointColor,
-        kAlpha, // 岻͸
+        kAlpha,     // 岻͸
+        kCellStyle, // CalendarCellStyle, 
     };
 
     enum CalendarSelectionMode
@@ -69,25 +189,64 @@ public:
         kRangeSelection
     };
 
+    // ʱЧ
+    enum ClickCommitMode
+    {
+        kAutoCommit,        // δdateDoubleClickedʱЧ, ȴ˫
+        kDeferredCommit,    // ȴ120ms, ȷϲ˫Ч
+        kSpeculativeCommit, // Ч, ˫ʱٷdateDoubleClicked, ˫Ĵǵ
+    };
+
 public:
     bool setYearMonth(int year, int month);
     void setFristDayOnWeek(int first_day_on_week);
     void setSelMode(CalendarSelectionMode select_mode);
+    void setClickCommitMode(ClickCommitMode mode) { click_commit_mode_ = mode; }
     void setSpecialDate(const QList<QDate>& dates);
+    void addSpecialDates(const QList<QDate>& dates);
+    void removeSpecialDates(const QList<QDate>& dates);
+    void setSpecialDateRange(const QDate& start_date, const QDate& end_date);
     void addSelectedDate(const QDate& date);
     void deleteSelectedDate(const QDate& date);
     void clearSelectedDate();
     void setMaxDate(const QDate& date);
     void setMinDate(const QDate& date);
     void setDateRange(const QDate& start_date, const QDate& end_date);
+    // ԷΧɫʾ[start_date, end_date], ˰ѡʽʾ; ÿԪֻȽ, 뷶Χ޹
+    // Чȡ
+    void setRangeBand(const QDate& start_date, const QDate& end_date);
+    // ֵ(¼), values[i]Ӧstart_date֮i, ͼʾ; 滻֮ǰõȫֵ
+    void setDayValues(const QDate& start_date, const std::vector<uint32_t>& values);
+    void clearDayValues();
+    // ͼɫӦֵ, 0ʾȡֵеֵ
+    void setHeatMaximum(quint32 maximum);
+    quint32 dayValue(const QDate& date) const;
+    // ṩڵԴ(תȨ, ٻȡǰЧ), һͬʾ; nullptrȡ
+    void setDataProvider(CalendarDataProvider* provider);
+    // Դݱ仯, 沢
+    void reloadProviderData();
+    // ذƽĹԹǷҳ, ĬϹرⷭͷ
+    void setWheelMomentum(bool enable) { wheel_momentum_ = enable; }
+    bool hasPreMonth();
+    bool hasNextMonth();
+    // Ⱦ¡¡², ڷҳ; ЧʱظȾ
+    void prefetchAdjacentMonths();
+    // offset: -1, 0, 1; ʧЧ򳬳ڷΧʱؿλͼ
+    QPixmap monthPixmap(int offset);
 
     int year() { return year_; }
     int month() { return month_; }
     int first_day_on_week() { return first_day_on_week_; }
     CalendarSelectionMode select_mode() { return select_mode_; }
-    QList<QDate> selected_date() { return selected_dates_; }
+    ClickCommitMode click_commit_mode() { return click_commit_mode_; }
+    QList<QDate> selected_date() { return selected_dates_.toList(); }
+    QList<QDate> special_date() { return special_dates_.toList(); }
+    // δDATETIMEEDIT_PROFILINGʱΪnullptr
+    PerfCounters* perfCounters() { return perf_counters_; }
     QDate max_date() { return max_date_; }
     QDate min_date() { return min_date_; }
+    CalendarDataProvider* data_provider() { return data_provider_; }
+    bool wheel_momentum() { return wheel_momentum_; }
 
 signals:
     void refresh(int year, int month);
@@ -97,22 +256,48 @@ signals:
     void maxDateChanged(const QDate& date);
     void minDateChanged(const QDate& date);
     void dateDoubleClicked(const QDate& date);
+    // ʾڼԤȾ·ݻ۱仯ʧЧ, ԤȾ
+    void monthCacheInvalidated();
 
 protected:
     bool eventFilter(QObject* obj, QEvent* ev) override;
+    void changeEvent(QEvent* ev) override;
 
 private slots:
-    void itemClicked(QTableWidgetItem* item);
-    void itemDoubleClicked(QTableWidgetItem* item);
+    void itemClicked(const QModelIndex& index);
+    void itemDoubleClicked(const QModelIndex& index);
     void clicked();
+    void clearPaintCache();
+    void todayChanged(const QDate& old_day, const QDate& new_day);
+    void stepWheelMonth();
 
 private:
     void refreshCalendar();
     void refreshCalendarHeader();
     void refreshSelection();
     void refreshSpecialDate();
-    void refreshTodayDate();
-    void startRefreshTimer();
+    void refreshVisibleSpecialDate();
+    bool loadVisibleSpecialMasks();
+    bool isSpecialCell(const CalendarModel::Cell& cell) const;
+    bool commitsClickImmediately() const;
+    quint8 heatLevel(qint64 julian_day) const;
+    bool isInRangeBand(qint64 julian_day) const
+    {
+        return julian_day >= band_first_julian_day_ && julian_day <= band_last_julian_day_;
+    }
+    bool isRangeBandEndpoint(qint64 julian_day) const
+    {
+        return isInRangeBand(julian_day)
+               && (julian_day == band_first_julian_day_ || julian_day == band_last_julian_day_);
+    }
+    bool isMonthCacheValid() const;
+    void invalidateMonthCache();
+
+    void wheelScrolled(QWheelEvent* ev);
+
+    void requestProviderData();
+    void cancelProviderRequest(int month_index);
+    void providerDataArrived(int month_index, const QFuture<QList<QDate>>& future);
 
     bool appendSelection(const QDate& date);
     bool removeSelection(const QDate& date);
@@ -123,45 +308,125 @@ private:
     int first_day_on_week_;
     QDate max_date_;
     QDate min_date_;
+    int max_month_index_;
+    int min_month_index_;
     QDate cliked_date_;
+    QModelIndex clicked_index_; // cliked_date_ڵĵԪ
     bool is_double_clicked_;
 
-    QTimer* date_timer_;
-    QList<QDate> selected_dates_;
-    QList<QDate> special_dates_;
+    CalendarModel* model_;
+    DateSet selected_dates_;
+    SpecialDateIndex special_dates_;
+    quint32 special_masks_[3]; // ǰʾ¡¡µ(Դı)
+
+    qint64 band_first_julian_day_; // band_last_julian_day_ʱʾûзΧ
+    qint64 band_last_julian_day_;
+
+    qint64 values_first_julian_day_;
+    std::vector<uint32_t> day_values_;
+    quint32 values_maximum_;
+    quint32 heat_maximum_;
+
+    using DatesWatcher = QFutureWatcher<QList<QDate>>;
+    CalendarDataProvider* data_provider_;
+    MonthMaskCache provider_masks_;
+    QHash<int, DatesWatcher*> provider_requests_; // ż¼δɵ
     CalendarSelectionMode select_mode_;
+    ClickCommitMode click_commit_mode_;
+
+    QPixmap month_cache_[3]; // ¡¡
+    int month_cache_index_;  // ʱʾ·, -1ʾʧЧ
+    quint32 month_cache_palette_;
+    QSize month_cache_size_;
+
+    QTimer* wheel_timer_;
+    int wheel_delta_;     // һµĹ, λͬQWheelEvent::angleDelta
+    int pending_months_;  // δҳ, ÿ֡෭һ
+    bool wheel_momentum_;
+    PerfCounters* perf_counters_;
 };
 
-class CalendarButtonGruop : public QWidget
+/**
+ * @brief ꡢѡҳĻ, kColumns x kRowsѡ, , ӿؼ
+ * ѡidʶ, ʾfirst_id()ʼkItemCountid
+ */
+class CalendarItemGrid : public QWidget
 {
     Q_OBJECT
 public:
-    explicit CalendarButtonGruop(QWidget* parent = nullptr)
-        : QWidget(parent){};
-    void setSelection(int id);
+    explicit CalendarItemGrid(QWidget* parent = nullptr);
+
+    static constexpr int kColumns = 4;
+    static constexpr int kRows = 3;
+    static constexpr int kItemCount = kColumns * kRows;
+
+    virtual void setSelection(int id);
+    int selection() const { return selected_id_; }
+
+    QSize sizeHint() const override;
 
 protected:
-    QList<QPushButton*> button_group_;
-    QSignalMapper* signal_mapper_;
+    virtual QString itemText(int id) const = 0;
+    virtual bool isItemEnabled(int /*id*/) const { return true; }
+    virtual void itemClicked(int id) = 0;
+
+    void setFirstId(int first_id);
+    int first_id() const { return first_id_; }
+    QRect itemRect(int index) const;
+    int itemAt(const QPoint& pos) const;
+
+    void paintEvent(QPaintEvent* ev) override;
+    void mouseMoveEvent(QMouseEvent* ev) override;
+    void mousePressEvent(QMouseEvent* ev) override;
+    void mouseReleaseEvent(QMouseEvent* ev) override;
+    void leaveEvent(QEvent* ev) override;
+
+private:
+    void setHoverIndex(int index);
+
+private:
+    int first_id_;
+    int selected_id_;
+    int hover_index_;
+    int pressed_index_;
 };
 
-class YearButtonGroup : public CalendarButtonGruop
+/**
+ * @brief ѡҳ, СڵݷΧڷҳй, ҳֻػһ
+ */
+class YearButtonGroup : public CalendarItemGrid
 {
     Q_OBJECT
 public:
     explicit YearButtonGroup(int year, QWidget* parent = nullptr);
 
+    void setSelection(int year) override;
+    void setYearRange(int min_year, int max_year);
     void toPreYearPage(int current_year);
     void toNextYearPage(int current_year);
 
 signals:
     void yearClicked(int year);
 
+protected:
+    QString itemText(int id) const override { return QString::number(id); }
+    bool isItemEnabled(int id) const override { return id >= min_year_ && id <= max_year_; }
+    void itemClicked(int id) override { emit yearClicked(id); }
+    void wheelEvent(QWheelEvent* ev) override;
+
+private:
+    void scrollToYear(int first_year);
+
 private:
-    void refreshYearPage(int show_year, int current_year);
+    int min_year_;
+    int max_year_;
+    int wheel_delta_;
 };
 
-class MonthButtonGroup : public CalendarButtonGruop
+/**
+ * @brief ·ѡҳ
+ */
+class MonthButtonGroup : public CalendarItemGrid
 {
     Q_OBJECT
 public:
@@ -169,6 +434,13 @@ public:
 
 signals:
     void monthClicked(int month);
+
+protected:
+    QString itemText(int id) const override { return month_texts_.value(id - 1); }
+    void itemClicked(int id) override { emit monthClicked(id); }
+
+private:
+    QStringList month_texts_;
 };
 
 #endif // CALENDARTABLE_H_
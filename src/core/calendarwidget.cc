@@ -1,15 +1,134 @@
 #include "calendarwidget.h"
 
-#include "flowlayout.h"
+#include <QElapsedTimer>
+#include <QMetaMethod>
+#include <QPainter>
+#include <QVBoxLayout>
+#include <QVariantAnimation>
+
 #include "iconfont/iconwidget.h"
 #include "styleresourcepool.h"
 
 constexpr int kDaysInWeek = 7;
 constexpr int kPointRadius = 1;
 constexpr int kCalendarRows = 6;
+constexpr int kTransitionDuration = 300;
+constexpr int kSlideDuration = 200;
+constexpr int kPrefetchDelay = 200;
+constexpr qint64 kFrameBudgetMs = 50; // 20֡ʱ
+constexpr int kMaxSlowTransitions = 3; // γԤŹرն, żĿֻζ
+
+/**
+ * @brief ҳлҳ, лǰҳȡһλͼ, ڼֻλͼ, ²ֺȾؼ
+ * ֡Ԥʱ, kMaxSlowTransitionsγԤٲŶ
+ */
+class ViewTransition : public QWidget
+{
+public:
+    enum Effect
+    {
+        kZoomIn,     // ҳķŴ󲢵, ҳ浭
+        kSlideLeft,  // 󻬶, ʾһҳ
+        kSlideRight, // һ, ʾһҳ
+    };
+
+    explicit ViewTransition(QWidget* parent)
+        : QWidget(parent)
+        , animation_(new QVariantAnimation(this))
+        , effect_(kZoomIn)
+        , progress_(0)
+        , slow_transitions_(0)
+    {
+        setAttribute(Qt::WA_OpaquePaintEvent);
+        setAttribute(Qt::WA_TransparentForMouseEvents);
+        hide();
+
+        animation_->setStartValue(0.0);
+        animation_->setEndValue(1.0);
+        connect(animation_, &QVariantAnimation::valueChanged, this, [this](const QVariant& value) {
+            if (frame_timer_.isValid() && frame_timer_.restart() > kFrameBudgetMs) {
+                ++slow_transitions_;
+                finish();
+                return;
+            }
+
+            progress_ = value.toReal();
+            update();
+        });
+        connect(animation_, &QVariantAnimation::finished, this, [this]() {
+            slow_transitions_ = 0;
+            finish();
+        });
+    }
+
+    bool isOverBudget() const { return slow_transitions_ >= kMaxSlowTransitions; }
+    bool isRunning() const { return animation_->state() == QAbstractAnimation::Running; }
+
+    // backgroundΪı
+    void start(const QPixmap& background, const QPixmap& from, const QPixmap& to, Effect effect)
+    {
+        background_ = background;
+        from_ = from;
+        to_ = to;
+        effect_ = effect;
+        progress_ = 0;
+
+        animation_->setDuration(effect == kZoomIn ? kTransitionDuration : kSlideDuration);
+        animation_->setEasingCurve(effect == kZoomIn ? QEasingCurve::Linear : QEasingCurve::OutCubic);
+
+        raise();
+        show();
+        frame_timer_.invalidate();
+        animation_->start();
+        frame_timer_.start();
+    }
+
+    void finish()
+    {
+        animation_->stop();
+        hide();
+
+        background_ = from_ = to_ = QPixmap();
+    }
+
+protected:
+    void paintEvent(QPaintEvent* /*ev*/) override
+    {
+        QPainter painter(this);
+        painter.drawPixmap(rect(), background_);
+
+        if (effect_ != kZoomIn) {
+            int direction = effect_ == kSlideLeft ? -1 : 1;
+            int offset = direction * qRound(width() * progress_);
+            painter.drawPixmap(QRect(QPoint(offset, 0), size()), from_);
+            painter.drawPixmap(QRect(QPoint(offset - direction * width(), 0), size()), to_);
+            return;
+        }
+
+        painter.setOpacity(1.0 - progress_);
+        painter.drawPixmap(rect(), from_);
+
+        QRectF target(width() * (1.0 - progress_) / 2, height() * (1.0 - progress_) / 2, width() * progress_,
+                      height() * progress_);
+        painter.setOpacity(progress_);
+        painter.drawPixmap(target, to_, QRectF(to_.rect()));
+    }
+
+private:
+    QPixmap background_;
+    QPixmap from_;
+    QPixmap to_;
+    QVariantAnimation* animation_;
+    QElapsedTimer frame_timer_;
+    Effect effect_;
+    qreal progress_;
+    int slow_transitions_; // ԤĴ
+};
 
 CalendarWidget::CalendarWidget(QWidget* parent, int year, int month)
     : QWidget(parent)
+    , reduced_motion_(false)
+    , month_slide_(false)
 {
     setAttribute(Qt::WA_StyledBackground);
 
@@ -37,8 +156,9 @@ CalendarWidget::CalendarWidget(QWidget* parent, int year, int month)
     next_btn_ = new IconButton(DefaultFont::ICON_YOU, this);
     next_btn_->setFixedSize(16, 16);
 
-    month_button_group_ = new MonthButtonGroup(this);
+    month_button_group_ = nullptr;
     year_button_group_ = new YearButtonGroup(year, this);
+    year_button_group_->setYearRange(calendar_->min_date().year(), calendar_->max_date().year());
 
     // źŲ۹
     connect(calendar_, &CalendarTable::refresh, this, &CalendarWidget::refresh);
@@ -48,12 +168,10 @@ CalendarWidget::CalendarWidget(QWidget* parent, int year, int month)
     connect(calendar_, &CalendarTable::selectionChanged, this, &CalendarWidget::calendarSelectionChanged);
     connect(calendar_, &CalendarTable::selectionAdded, this, &CalendarWidget::calendarSelectionAdded);
     connect(calendar_, &CalendarTable::selectionDeleted, this, &CalendarWidget::calendarSelectionDeleted);
-    connect(calendar_, &CalendarTable::dateDoubleClicked, this, &CalendarWidget::dateDoubleClicked);
     connect(pre_btn_, &QPushButton::clicked, this, &CalendarWidget::pre);
     connect(next_btn_, &QPushButton::clicked, this, &CalendarWidget::next);
     connect(month_btn_, &QPushButton::clicked, this, &CalendarWidget::viewChanged);
     connect(year_btn_, &QPushButton::clicked, this, &CalendarWidget::viewChanged);
-    connect(month_button_group_, &MonthButtonGroup::monthClicked, this, &CalendarWidget::monthClicked);
     connect(year_button_group_, &YearButtonGroup::yearClicked, this, &CalendarWidget::yearClicked);
 
     // 
@@ -81,7 +199,6 @@ CalendarWidget::CalendarWidget(QWidget* parent, int year, int month)
     view_stacked_widget_ = new QStackedWidget(this);
     view_stacked_widget_->setContentsMargins(0, 0, 0, 0);
     view_stacked_widget_->insertWidget(kViewDate, calendar_table_widget);
-    view_stacked_widget_->insertWidget(kViewMonth, month_button_group_);
     view_stacked_widget_->insertWidget(kViewYear, year_button_group_);
 
     main_layout_ = new QVBoxLayout(this);
@@ -93,7 +210,14 @@ CalendarWidget::CalendarWidget(QWidget* parent, int year, int month)
     main_layout_->addWidget(view_stacked_widget_);
     main_layout_->addStretch();
 
-    initAnimation();
+    transition_ = new ViewTransition(this);
+
+    prefetch_timer_ = new QTimer(this);
+    prefetch_timer_->setSingleShot(true);
+    prefetch_timer_->setInterval(kPrefetchDelay);
+    connect(prefetch_timer_, &QTimer::timeout, this, &CalendarWidget::prefetchMonths);
+    connect(calendar_, &CalendarTable::selectionChanged, this, &CalendarWidget::schedulePrefetch);
+    connect(calendar_, &CalendarTable::monthCacheInvalidated, this, &CalendarWidget::schedulePrefetch);
 
     refreshNextEnable();
     refreshPreEnable();
@@ -106,6 +230,25 @@ void CalendarWidget::setTitle(const QString& title)
     title_->setText(title);
 }
 
+void CalendarWidget::connectNotify(const QMetaMethod& signal)
+{
+    // ˴˫ʱת, ĵЧ(CalendarTable::kAutoCommit)
+    if (signal == QMetaMethod::fromSignal(&CalendarWidget::dateDoubleClicked)) {
+        connect(calendar_, &CalendarTable::dateDoubleClicked, this, &CalendarWidget::dateDoubleClicked,
+                Qt::UniqueConnection);
+    }
+}
+
+void CalendarWidget::disconnectNotify(const QMetaMethod& signal)
+{
+    static const QMetaMethod double_clicked_signal = QMetaMethod::fromSignal(&CalendarWidget::dateDoubleClicked);
+
+    // disconnect()ϿʱsignalЧ
+    if ((!signal.isValid() || signal == double_clicked_signal) && !isSignalConnected(double_clicked_signal)) {
+        disconnect(calendar_, &CalendarTable::dateDoubleClicked, this, &CalendarWidget::dateDoubleClicked);
+    }
+}
+
 void CalendarWidget::refresh(int year, int month)
 {
     month_btn_->setText(GET_TXT(QString("IDCS_MONTH_%1").arg(QString::number(month))));
@@ -114,20 +257,26 @@ void CalendarWidget::refresh(int year, int month)
 
     refreshNextEnable();
     refreshPreEnable();
+    schedulePrefetch();
 }
 
 void CalendarWidget::calendarMaxDateChanged(const QDate& /*date*/)
 {
+    year_button_group_->setYearRange(calendar_->min_date().year(), calendar_->max_date().year());
     refreshNextEnable();
 }
 
 void CalendarWidget::calendarMinDateChanged(const QDate& /*date*/)
 {
+    year_button_group_->setYearRange(calendar_->min_date().year(), calendar_->max_date().year());
     refreshPreEnable();
 }
 
 void CalendarWidget::viewChanged()
 {
+    transition_->finish();
+    QPixmap from = isAnimated() ? grabView() : QPixmap();
+
     pre_btn_->setEnabled(true);
     next_btn_->setEnabled(true);
 
@@ -135,6 +284,13 @@ void CalendarWidget::viewChanged()
         if (view_stacked_widget_->currentIndex() == kViewMonth) {
             view_stacked_widget_->setCurrentIndex(kViewDate);
         } else {
+            // ·ҳ״ʹʱŴ
+            if (!month_button_group_) {
+                month_button_group_ = new MonthButtonGroup(this);
+                connect(month_button_group_, &MonthButtonGroup::monthClicked, this, &CalendarWidget::monthClicked);
+                view_stacked_widget_->insertWidget(kViewMonth, month_button_group_);
+            }
+
             month_button_group_->setSelection(month_btn_->property("month").toInt());
             view_stacked_widget_->setCurrentIndex(kViewMonth);
             pre_btn_->setEnabled(false);
@@ -149,20 +305,18 @@ void CalendarWidget::viewChanged()
         }
     }
 
-    int x = view_stacked_widget_->x();
-    int y = view_stacked_widget_->y();
-    int w = view_stacked_widget_->rect().width();
-    int h = view_stacked_widget_->rect().height();
-    geometry_animation_->setStartValue(QRect(x + w / 2, y + h / 2, 0, 0));
-    geometry_animation_->setEndValue(QRect(x, y, w, h));
+    if (!from.isNull())
+        startTransition(from);
 
-    animation_group_->start();
+    schedulePrefetch();
 }
 
 void CalendarWidget::pre()
 {
     if (view_stacked_widget_->currentIndex() == kViewYear) {
         year_button_group_->toPreYearPage(year_btn_->text().toInt());
+    } else if (month_slide_ && isAnimated()) {
+        slideMonth(-1);
     } else {
         calendar_->setYearMonth(calendar_->year(), calendar_->month() - 1);
     }
@@ -172,6 +326,8 @@ void CalendarWidget::next()
 {
     if (view_stacked_widget_->currentIndex() == kViewYear) {
         year_button_group_->toNextYearPage(year_btn_->text().toInt());
+    } else if (month_slide_ && isAnimated()) {
+        slideMonth(1);
     } else {
         calendar_->setYearMonth(calendar_->year(), calendar_->month() + 1);
     }
@@ -193,25 +349,88 @@ void CalendarWidget::yearClicked(int year)
     next_btn_->setEnabled(true);
 }
 
-void CalendarWidget::initAnimation()
+bool CalendarWidget::isAnimated() const
+{
+    return !reduced_motion_ && !transition_->isOverBudget() && isVisible();
+}
+
+QPixmap CalendarWidget::grabView()
 {
-    auto graphics_opacity_effect = new QGraphicsOpacityEffect(this);
-    graphics_opacity_effect->setOpacity(1.0);
-    view_stacked_widget_->setGraphicsEffect(graphics_opacity_effect);
+    return grab(view_stacked_widget_->geometry());
+}
+
+QPixmap CalendarWidget::grabBackground(const QRect& rect)
+{
+    // ֻƱؼı(ʽ), ΪҳΧĵɫ
+    qreal dpr = devicePixelRatioF();
+    QPixmap background(rect.size() * dpr);
+    background.setDevicePixelRatio(dpr);
+    background.fill(palette().color(QPalette::Window));
+    render(&background, QPoint(), QRegion(rect), QWidget::DrawWindowBackground);
+
+    return background;
+}
 
-    auto opacity_animation = new QPropertyAnimation(graphics_opacity_effect, "opacity", this);
-    opacity_animation->setStartValue(0.0);
-    opacity_animation->setEndValue(1.0);
-    opacity_animation->setDuration(300);
-    opacity_animation->setEasingCurve(QEasingCurve::Linear);
+void CalendarWidget::startTransition(const QPixmap& from)
+{
+    QRect rect = view_stacked_widget_->geometry();
+
+    // ״δ򿪵·ҳղ, δ
+    view_stacked_widget_->layout()->activate();
+
+    transition_->setGeometry(rect);
+    transition_->start(grabBackground(rect), from, grabView(), ViewTransition::kZoomIn);
+}
 
-    geometry_animation_ = new QPropertyAnimation(view_stacked_widget_, "geometry");
-    geometry_animation_->setDuration(300);
-    geometry_animation_->setEasingCurve(QEasingCurve::Linear);
+void CalendarWidget::setMonthSlide(bool enable)
+{
+    month_slide_ = enable;
+    schedulePrefetch();
+}
+
+void CalendarWidget::slideMonth(int offset)
+{
+    transition_->finish();
+
+    // Եǰ·Ϊ׼, ڷҳǰȡ
+    QPixmap from = calendar_->monthPixmap(0);
+    QPixmap to = calendar_->monthPixmap(offset);
+
+    if (!calendar_->setYearMonth(calendar_->year(), calendar_->month() + offset))
+        return;
 
-    animation_group_ = new QParallelAnimationGroup(this);
-    animation_group_->addAnimation(opacity_animation);
-    animation_group_->addAnimation(geometry_animation_);
+    // δԤȾʱֱӷҳ
+    if (from.isNull() || to.isNull())
+        return;
+
+    QRect rect(calendar_->mapTo(this, QPoint(0, 0)), calendar_->size());
+    transition_->setGeometry(rect);
+    transition_->start(grabBackground(rect), from, to,
+                       offset > 0 ? ViewTransition::kSlideLeft : ViewTransition::kSlideRight);
+}
+
+void CalendarWidget::schedulePrefetch()
+{
+    if (month_slide_)
+        prefetch_timer_->start();
+}
+
+void CalendarWidget::prefetchMonths()
+{
+    // ڼȾɿ, ȶȾ
+    if (transition_->isRunning()) {
+        prefetch_timer_->start();
+        return;
+    }
+
+    if (month_slide_ && isAnimated() && view_stacked_widget_->currentIndex() == kViewDate)
+        calendar_->prefetchAdjacentMonths();
+}
+
+void CalendarWidget::showEvent(QShowEvent* ev)
+{
+    schedulePrefetch();
+    QWidget::showEvent(ev);
 }
 
 void CalendarWidget::refreshNextEnable()
@@ -219,8 +438,7 @@ void CalendarWidget::refreshNextEnable()
     if (view_stacked_widget_->currentIndex() == kViewMonth)
         return;
 
-    next_btn_->setEnabled(QDate(calendar_->year(), calendar_->month(), 1)
-                          < QDate(calendar_->max_date().year(), calendar_->max_date().month(), 1));
+    next_btn_->setEnabled(calendar_->hasNextMonth());
 }
 
 void CalendarWidget::refreshPreEnable()
@@ -228,8 +446,7 @@ void CalendarWidget::refreshPreEnable()
     if (view_stacked_widget_->currentIndex() == kViewMonth)
         return;
 
-    pre_btn_->setEnabled(QDate(calendar_->year(), calendar_->month(), calendar_->min_date().day())
-                         > QDate(calendar_->min_date().year(), calendar_->min_date().month(), 1));
+    pre_btn_->setEnabled(calendar_->hasPreMonth());
 }
 
 #include "moc_calendarwidget.cpp"
@@ -2,8 +2,6 @@
 #define CALANDARWIDGET_H_
 
 #include <QHeaderView>
-#include <QParallelAnimationGroup>
-#include <QPropertyAnimation>
 
 #include "calendartable.h"
 #include "datetimeedit_global.h"
@@ -25,22 +23,45 @@ public:
     void addLayoutBottom(QLayout* layout) { main_layout_->addLayout(layout); }
     void addSelectedDate(const QDate& date) { calendar_->addSelectedDate(date); }
     void setSpecialDate(const QList<QDate>& dates) { calendar_->setSpecialDate(dates); }
+    void addSpecialDates(const QList<QDate>& dates) { calendar_->addSpecialDates(dates); }
+    void removeSpecialDates(const QList<QDate>& dates) { calendar_->removeSpecialDates(dates); }
+    void setSpecialDateRange(const QDate& start_date, const QDate& end_date)
+    {
+        calendar_->setSpecialDateRange(start_date, end_date);
+    }
+    void setDayValues(const QDate& start_date, const std::vector<uint32_t>& values)
+    {
+        calendar_->setDayValues(start_date, values);
+    }
+    void clearDayValues() { calendar_->clearDayValues(); }
+    void setHeatMaximum(quint32 maximum) { calendar_->setHeatMaximum(maximum); }
+    void setDataProvider(CalendarDataProvider* provider) { calendar_->setDataProvider(provider); }
+    void reloadProviderData() { calendar_->reloadProviderData(); }
     void deleteSelectedDate(const QDate& date) { calendar_->deleteSelectedDate(date); }
     void clearSelectedDate() { calendar_->clearSelectedDate(); }
 
     bool setYearMonth(int year, int month) { return calendar_->setYearMonth(year, month); }
     void setSelMode(CalendarTable::CalendarSelectionMode select_mode) { calendar_->setSelMode(select_mode); }
+    void setClickCommitMode(CalendarTable::ClickCommitMode mode) { calendar_->setClickCommitMode(mode); }
     void setMaxDate(const QDate& date) { calendar_->setMaxDate(date); }
     void setMinDate(const QDate& date) { calendar_->setMinDate(date); }
     void setDateRange(const QDate& start_date, const QDate& end_date) { calendar_->setDateRange(start_date, end_date); }
+    void setRangeBand(const QDate& start_date, const QDate& end_date) { calendar_->setRangeBand(start_date, end_date); }
     void setTitle(const QString& title);
+    // ٶ: лڡ¡ҳʱŹɶ
+    void setReducedMotion(bool reduced) { reduced_motion_ = reduced; }
+    // ҳʱˮƽ, ·ڿʱԤȾ
+    void setMonthSlide(bool enable);
 
     QDate max_date() { return calendar_->max_date(); }
     QDate min_date() { return calendar_->min_date(); }
     QList<QDate> selected_date() { return calendar_->selected_date(); }
+    QList<QDate> special_date() { return calendar_->special_date(); }
 
     int year() { return calendar_->year(); }
     int month() { return calendar_->month(); }
+    bool reduced_motion() { return reduced_motion_; }
+    bool month_slide() { return month_slide_; }
 
 signals:
     void calendarSelectionChanged();
@@ -49,6 +70,11 @@ signals:
     void calendarRefresh(int year, int month);
     void dateDoubleClicked(const QDate& date);
 
+protected:
+    void showEvent(QShowEvent* ev) override;
+    void connectNotify(const QMetaMethod& signal) override;
+    void disconnectNotify(const QMetaMethod& signal) override;
+
 private slots:
     void refresh(int year, int month);
     void calendarMaxDateChanged(const QDate& date);
@@ -58,16 +84,23 @@ private slots:
     void next();
     void monthClicked(int month);
     void yearClicked(int year);
+    void prefetchMonths();
 
 private:
+    // view_stacked_widget_е˳һ, ·ҳ״ʹʱӵ
     enum CalendarViewType
     {
         kViewDate,
-        kViewMonth,
-        kViewYear
+        kViewYear,
+        kViewMonth
     };
 
-    void initAnimation();
+    bool isAnimated() const;
+    QPixmap grabView();
+    QPixmap grabBackground(const QRect& rect);
+    void startTransition(const QPixmap& from);
+    void slideMonth(int offset);
+    void schedulePrefetch();
 
     void refreshNextEnable();
     void refreshPreEnable();
@@ -86,8 +119,10 @@ private:
     QStackedWidget* view_stacked_widget_;
     QVBoxLayout* main_layout_;
 
-    QPropertyAnimation* geometry_animation_;
-    QParallelAnimationGroup* animation_group_;
+    class ViewTransition* transition_;
+    QTimer* prefetch_timer_;
+    bool reduced_motion_;
+    bool month_slide_;
 };
 
 #endif // DateTimeEdit_H_
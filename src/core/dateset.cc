@@ -0,0 +1,239 @@
+#include "dateset.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "calendargrid.h"
+
+bool DateSet::contains(const QDate& date) const
+{
+    return date.isValid() && containsJulianDay(date.toJulianDay());
+}
+
+bool DateSet::containsJulianDay(qint64 julian_day) const
+{
+    if (order_.isEmpty())
+        return false;
+
+    auto it = words_.constFind(wordKey(julian_day));
+    return it != words_.constEnd() && (it.value() & wordBit(julian_day));
+}
+
+bool DateSet::insert(const QDate& date)
+{
+    if (!date.isValid())
+        return false;
+
+    qint64 julian_day = date.toJulianDay();
+    quint64& word = words_[wordKey(julian_day)];
+    if (word & wordBit(julian_day))
+        return false;
+
+    word |= wordBit(julian_day);
+    order_.append(julian_day);
+    return true;
+}
+
+bool DateSet::remove(const QDate& date)
+{
+    if (!date.isValid())
+        return false;
+
+    qint64 julian_day = date.toJulianDay();
+    auto it = words_.find(wordKey(julian_day));
+    if (it == words_.end() || !(it.value() & wordBit(julian_day)))
+        return false;
+
+    it.value() &= ~wordBit(julian_day);
+    if (!it.value())
+        words_.erase(it);
+
+    order_.removeOne(julian_day);
+    return true;
+}
+
+void DateSet::clear()
+{
+    words_.clear();
+    order_.clear();
+}
+
+QDate DateSet::first() const
+{
+    return order_.isEmpty() ? QDate() : QDate::fromJulianDay(order_.first());
+}
+
+QList<QDate> DateSet::toList() const
+{
+    QList<QDate> dates;
+    dates.reserve(order_.size());
+    for (qint64 julian_day : order_) {
+        dates.append(QDate::fromJulianDay(julian_day));
+    }
+
+    return dates;
+}
+
+void SpecialDateIndex::set(const QList<QDate>& dates)
+{
+    julian_days_ = sortedJulianDays(dates);
+    rebuildMonthMasks();
+}
+
+void SpecialDateIndex::setRange(const QDate& start_date, const QDate& end_date)
+{
+    clear();
+    if (!start_date.isValid() || !end_date.isValid() || start_date > end_date)
+        return;
+
+    qint64 start = start_date.toJulianDay();
+    qint64 end = end_date.toJulianDay();
+    julian_days_.reserve(int(end - start + 1));
+    for (qint64 julian_day = start; julian_day <= end; ++julian_day) {
+        julian_days_.append(julian_day);
+    }
+
+    // Fill the month summary month by month, without converting every day.
+    int year, month, day;
+    start_date.getDate(&year, &month, &day);
+    int end_index = CalendarMath::monthIndex(end_date.year(), end_date.month());
+    int end_day = end_date.day();
+    for (int index = CalendarMath::monthIndex(year, month); index <= end_index; ++index) {
+        int month_days = CalendarMath::daysInMonth(CalendarMath::yearOfMonthIndex(index),
+                                                   CalendarMath::monthOfMonthIndex(index));
+        int last_day = (index == end_index) ? end_day : month_days;
+        quint32 mask = ((quint32(1) << last_day) - 1) & ~((quint32(1) << (day - 1)) - 1);
+        month_masks_.insert(index, mask);
+        day = 1;
+    }
+}
+
+bool SpecialDateIndex::add(const QList<QDate>& dates)
+{
+    QVector<qint64> added = sortedJulianDays(dates);
+    if (added.isEmpty())
+        return false;
+
+    QVector<qint64> merged;
+    merged.reserve(julian_days_.size() + added.size());
+    std::set_union(julian_days_.cbegin(), julian_days_.cend(), added.cbegin(), added.cend(),
+                   std::back_inserter(merged));
+    if (merged.size() == julian_days_.size())
+        return false;
+
+    julian_days_.swap(merged);
+    for (const QDate& date : dates) {
+        if (!date.isValid())
+            continue;
+
+        int year, month, day;
+        date.getDate(&year, &month, &day);
+        month_masks_[CalendarMath::monthIndex(year, month)] |= quint32(1) << (day - 1);
+    }
+    return true;
+}
+
+bool SpecialDateIndex::remove(const QList<QDate>& dates)
+{
+    QVector<qint64> removed = sortedJulianDays(dates);
+    if (removed.isEmpty() || julian_days_.isEmpty())
+        return false;
+
+    QVector<qint64> rest;
+    rest.reserve(julian_days_.size());
+    std::set_difference(julian_days_.cbegin(), julian_days_.cend(), removed.cbegin(), removed.cend(),
+                        std::back_inserter(rest));
+    if (rest.size() == julian_days_.size())
+        return false;
+
+    julian_days_.swap(rest);
+    for (const QDate& date : dates) {
+        if (!date.isValid())
+            continue;
+
+        int year, month, day;
+        date.getDate(&year, &month, &day);
+        auto it = month_masks_.find(CalendarMath::monthIndex(year, month));
+        if (it == month_masks_.end())
+            continue;
+
+        it.value() &= ~(quint32(1) << (day - 1));
+        if (!it.value())
+            month_masks_.erase(it);
+    }
+    return true;
+}
+
+void SpecialDateIndex::clear()
+{
+    julian_days_.clear();
+    month_masks_.clear();
+}
+
+bool SpecialDateIndex::contains(const QDate& date) const
+{
+    return date.isValid() && std::binary_search(julian_days_.cbegin(), julian_days_.cend(), date.toJulianDay());
+}
+
+QList<QDate> SpecialDateIndex::toList() const
+{
+    QList<QDate> dates;
+    dates.reserve(julian_days_.size());
+    for (qint64 julian_day : julian_days_) {
+        dates.append(QDate::fromJulianDay(julian_day));
+    }
+    return dates;
+}
+
+QVector<qint64> SpecialDateIndex::sortedJulianDays(const QList<QDate>& dates)
+{
+    QVector<qint64> julian_days;
+    julian_days.reserve(dates.size());
+    for (const QDate& date : dates) {
+        if (date.isValid())
+            julian_days.append(date.toJulianDay());
+    }
+
+    std::sort(julian_days.begin(), julian_days.end());
+    julian_days.erase(std::unique(julian_days.begin(), julian_days.end()), julian_days.end());
+    return julian_days;
+}
+
+void SpecialDateIndex::rebuildMonthMasks()
+{
+    month_masks_.clear();
+    for (qint64 julian_day : julian_days_) {
+        int year, month, day;
+        QDate::fromJulianDay(julian_day).getDate(&year, &month, &day);
+        month_masks_[CalendarMath::monthIndex(year, month)] |= quint32(1) << (day - 1);
+    }
+}
+
+MonthMaskCache::MonthMaskCache(int capacity)
+    : capacity_(qMax(capacity, 1))
+    , tick_(0)
+{}
+
+quint32 MonthMaskCache::mask(int month_index)
+{
+    auto it = entries_.find(month_index);
+    if (it == entries_.end())
+        return 0;
+
+    it->last_used = ++tick_;
+    return it->mask;
+}
+
+void MonthMaskCache::insert(int month_index, quint32 mask)
+{
+    if (!entries_.contains(month_index) && entries_.size() >= capacity_) {
+        auto lru = entries_.begin();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->last_used < lru->last_used)
+                lru = it;
+        }
+        entries_.erase(lru);
+    }
+
+    entries_.insert(month_index, Entry{mask, ++tick_});
+}
@@ -0,0 +1,94 @@
+#ifndef DATESET_H_
+#define DATESET_H_
+
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+/**
+ * @brief ڼϣΪϡλͼÿ64һ֣ѯ/ΪO(1)
+ * ˳¼: first()ΪȲ, toList()˳򷵻
+ */
+class DateSet
+{
+public:
+    bool contains(const QDate& date) const;
+    bool containsJulianDay(qint64 julian_day) const;
+    bool insert(const QDate& date);
+    bool remove(const QDate& date);
+    void clear();
+
+    int size() const { return order_.size(); }
+    bool isEmpty() const { return order_.isEmpty(); }
+
+    QDate first() const;
+    QList<QDate> toList() const;
+
+private:
+    static qint64 wordKey(qint64 julian_day) { return julian_day >> 6; }
+    static quint64 wordBit(qint64 julian_day) { return quint64(1) << (julian_day & 63); }
+
+private:
+    QHash<qint64, quint64> words_;
+    QVector<qint64> order_; // ˳, ɾʱԲ(ѡֻͨм)
+};
+
+/**
+ * @brief  + µλժҪ(nλӦn+1)
+ * ֧ɾ²ѯΪO(1)
+ */
+class SpecialDateIndex
+{
+public:
+    void set(const QList<QDate>& dates);
+    void setRange(const QDate& start_date, const QDate& end_date);
+    bool add(const QList<QDate>& dates);
+    bool remove(const QList<QDate>& dates);
+    void clear();
+
+    int size() const { return julian_days_.size(); }
+    bool isEmpty() const { return julian_days_.isEmpty(); }
+    bool contains(const QDate& date) const;
+
+    // month_index: CalendarMath::monthIndex(year, month)
+    quint32 monthMask(int month_index) const { return month_masks_.value(month_index); }
+
+    QList<QDate> toList() const;
+
+private:
+    static QVector<qint64> sortedJulianDays(const QList<QDate>& dates);
+    void rebuildMonthMasks();
+
+private:
+    QVector<qint64> julian_days_;
+    QHash<int, quint32> month_masks_;
+};
+
+/**
+ * @brief »(nλӦn+1), ʱ̭δʹõ·
+ */
+class MonthMaskCache
+{
+public:
+    explicit MonthMaskCache(int capacity);
+
+    bool contains(int month_index) const { return entries_.contains(month_index); }
+    // ʱ0, ѯͬʱ¸µʹʱ
+    quint32 mask(int month_index);
+    void insert(int month_index, quint32 mask);
+    void clear() { entries_.clear(); }
+
+private:
+    struct Entry
+    {
+        quint32 mask;
+        quint32 last_used;
+    };
+
+    int capacity_;
+    quint32 tick_;
+    QHash<int, Entry> entries_;
+};
+
+#endif // DATESET_H_
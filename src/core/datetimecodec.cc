@@ -0,0 +1,266 @@
+#include "datetimecodec.h"
+
+#include <cstring>
+
+#include "calendargrid.h"
+
+constexpr qint64 DateTimeCodec::kInvalidSecs;
+constexpr int DateTimeCodec::kChunkCount;
+constexpr int DateTimeCodec::kMaxWidth;
+
+namespace {
+
+constexpr qint64 kSecsPerDay = 86400;
+constexpr qint64 kEpochJulianDay = 2440588; // 1970-01-01
+
+constexpr quint64 kHighNibbles = Q_UINT64_C(0xF0F0F0F0F0F0F0F0);
+constexpr quint64 kDigitNibbles = Q_UINT64_C(0x3030303030303030);
+constexpr quint64 kSixes = Q_UINT64_C(0x0606060606060606);
+
+const char kDigitPairs[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+inline void writeTwoDigits(char* out, int value)
+{
+    std::memcpy(out, kDigitPairs + 2 * value, 2);
+}
+
+inline int readTwoDigits(const char* text)
+{
+    return (text[0] - '0') * 10 + (text[1] - '0');
+}
+
+inline quint64 loadChunk(const char* bytes)
+{
+    quint64 chunk;
+    std::memcpy(&chunk, bytes, sizeof(chunk));
+    return chunk;
+}
+
+} // namespace
+
+DateTimeCodec::DateTimeCodec(const QString& format)
+    : format_(format)
+    , fixed_(false)
+    , width_(0)
+    , chunk_count_(0)
+{
+    parseLayout();
+}
+
+void DateTimeCodec::parseLayout()
+{
+    std::memset(offsets_, -1, sizeof(offsets_));
+    std::memset(pattern_, 0, sizeof(pattern_));
+
+    static const struct
+    {
+        const char* token;
+        Field field;
+    } kTokens[] = {
+        {"yyyy", kYear}, {"MM", kMonth}, {"dd", kDay}, {"hh", kHour}, {"HH", kHour}, {"mm", kMinute}, {"ss", kSecond},
+    };
+
+    // ֻASCIIָ("yyyyMMdd"˵QDateTime): toLatin1()ַ滻Ϊ'?',
+    // 0xFAϵֽУлλڵλ
+    for (QChar ch : format_) {
+        if (ch.unicode() >= 0x80)
+            return;
+    }
+
+    char digits[kMaxWidth] = {};
+    QByteArray format = format_.toLatin1();
+    if (format.size() > kMaxWidth)
+        return;
+
+    int pos = 0;
+    while (pos < format.size()) {
+        bool matched = false;
+        for (const auto& token : kTokens) {
+            int length = int(std::strlen(token.token));
+            if (!format.mid(pos, length).startsWith(token.token))
+                continue;
+
+            // ڵͬһĸʾ(yyyyy), Ƕʽ
+            char next = pos + length < format.size() ? format.at(pos + length) : '\0';
+            if (next == token.token[0] || offsets_[token.field] >= 0)
+                return;
+
+            offsets_[token.field] = qint8(pos);
+            for (int i = 0; i < length; ++i) {
+                pattern_[pos + i] = '0';
+                digits[pos + i] = 1;
+            }
+            pos += length;
+            matched = true;
+            break;
+        }
+
+        if (!matched) {
+            char ch = format.at(pos);
+            if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '\'')
+                return;
+
+            pattern_[pos++] = ch;
+        }
+    }
+
+    if (offsets_[kYear] < 0 || offsets_[kMonth] < 0 || offsets_[kDay] < 0)
+        return;
+
+    width_ = format.size();
+    chunk_count_ = (width_ + 7) / 8;
+    for (int i = 0; i < chunk_count_; ++i) {
+        char literal_mask[8] = {};
+        char digit_mask[8] = {};
+        for (int j = 0; j < 8; ++j) {
+            int index = i * 8 + j;
+            if (index >= width_)
+                continue;
+            digit_mask[j] = digits[index] ? char(0xF0) : 0;
+            literal_mask[j] = digits[index] ? 0 : char(0xFF);
+        }
+        literals_[i] = loadChunk(pattern_ + i * 8);
+        literal_masks_[i] = loadChunk(literal_mask);
+        digit_masks_[i] = loadChunk(digit_mask);
+    }
+
+    fixed_ = true;
+}
+
+bool DateTimeCodec::parseFields(const char* text, int fields[kFieldCount]) const
+{
+    char buffer[kMaxWidth] = {};
+    std::memcpy(buffer, text, width_);
+
+    // һֽ, ҽ4λΪ3Ҽ64λΪ3; λֻԱѲϷֽ
+    quint64 bad = 0;
+    for (int i = 0; i < chunk_count_; ++i) {
+        quint64 chunk = loadChunk(buffer + i * 8);
+        bad |= (chunk ^ literals_[i]) & literal_masks_[i];
+        bad |= (((chunk & kHighNibbles) ^ kDigitNibbles) | (((chunk + kSixes) & kHighNibbles) ^ kDigitNibbles))
+               & digit_masks_[i];
+    }
+    if (bad)
+        return false;
+
+    const char* year = buffer + offsets_[kYear];
+    fields[kYear] = readTwoDigits(year) * 100 + readTwoDigits(year + 2);
+    for (int field = kMonth; field < kFieldCount; ++field) {
+        fields[field] = offsets_[field] >= 0 ? readTwoDigits(buffer + offsets_[field]) : 0;
+    }
+
+    unsigned invalid = unsigned(fields[kMonth] - 1) > 11u;
+    invalid |= unsigned(fields[kHour]) > 23u;
+    invalid |= unsigned(fields[kMinute]) > 59u;
+    invalid |= unsigned(fields[kSecond]) > 59u;
+    if (invalid)
+        return false;
+
+    return unsigned(fields[kDay] - 1) < unsigned(CalendarMath::daysInMonth(fields[kYear], fields[kMonth]));
+}
+
+void DateTimeCodec::formatFields(const int fields[kFieldCount], char* out) const
+{
+    std::memcpy(out, pattern_, width_);
+
+    char* year = out + offsets_[kYear];
+    writeTwoDigits(year, fields[kYear] / 100);
+    writeTwoDigits(year + 2, fields[kYear] % 100);
+    for (int field = kMonth; field < kFieldCount; ++field) {
+        if (offsets_[field] >= 0)
+            writeTwoDigits(out + offsets_[field], fields[field]);
+    }
+}
+
+QString DateTimeCodec::toString(const QDateTime& date_time) const
+{
+    QDate date = date_time.date();
+    if (!fixed_ || !date_time.isValid() || date.year() < 0 || date.year() > 9999)
+        return date_time.toString(format_);
+
+    QTime time = date_time.time();
+    int fields[kFieldCount] = {date.year(), date.month(), date.day(), time.hour(), time.minute(), time.second()};
+
+    char buffer[kMaxWidth];
+    formatFields(fields, buffer);
+    return QString::fromLatin1(buffer, width_);
+}
+
+QDateTime DateTimeCodec::fromString(const QString& text) const
+{
+    if (!fixed_ || text.size() != width_)
+        return QDateTime::fromString(text, format_);
+
+    // ASCIIַ滻Ϊ0xFF, УʱȻʧ
+    char buffer[kMaxWidth];
+    const QChar* chars = text.constData();
+    for (int i = 0; i < width_; ++i) {
+        ushort unicode = chars[i].unicode();
+        buffer[i] = unicode < 0x80 ? char(unicode) : char(0xFF);
+    }
+
+    int fields[kFieldCount];
+    if (!parseFields(buffer, fields))
+        return QDateTime::fromString(text, format_);
+
+    return QDateTime(QDate(fields[kYear], fields[kMonth], fields[kDay]),
+                     QTime(fields[kHour], fields[kMinute], fields[kSecond]));
+}
+
+int DateTimeCodec::formatBatch(const qint64* secs, int count, char* out, int stride) const
+{
+    if (!fixed_ || stride < width_)
+        return 0;
+
+    // 0000-01-01 00:00:00  9999-12-31 23:59:59
+    const qint64 min_secs = (CalendarMath::julianDay(0, 1, 1) - kEpochJulianDay) * kSecsPerDay;
+    const qint64 max_secs = (CalendarMath::julianDay(10000, 1, 1) - kEpochJulianDay) * kSecsPerDay - 1;
+
+    int formatted = 0;
+    for (int i = 0; i < count; ++i, out += stride) {
+        qint64 value = secs[i];
+        if (value < min_secs || value > max_secs) {
+            std::memset(out, ' ', width_);
+            continue;
+        }
+
+        qint64 days = (value - min_secs) / kSecsPerDay;
+        int secs_of_day = int(value - min_secs - days * kSecsPerDay);
+
+        int fields[kFieldCount];
+        CalendarMath::civilFromJulianDay(days + CalendarMath::julianDay(0, 1, 1), &fields[kYear], &fields[kMonth],
+                                         &fields[kDay]);
+        fields[kHour] = secs_of_day / 3600;
+        fields[kMinute] = secs_of_day / 60 % 60;
+        fields[kSecond] = secs_of_day % 60;
+
+        formatFields(fields, out);
+        ++formatted;
+    }
+    return formatted;
+}
+
+int DateTimeCodec::parseBatch(const char* text, int count, int stride, qint64* secs) const
+{
+    if (!fixed_ || stride < width_)
+        return 0;
+
+    int parsed = 0;
+    for (int i = 0; i < count; ++i, text += stride) {
+        int fields[kFieldCount];
+        if (!parseFields(text, fields)) {
+            secs[i] = kInvalidSecs;
+            continue;
+        }
+
+        qint64 days = CalendarMath::julianDay(fields[kYear], fields[kMonth], fields[kDay]) - kEpochJulianDay;
+        secs[i] = days * kSecsPerDay + fields[kHour] * 3600 + fields[kMinute] * 60 + fields[kSecond];
+        ++parsed;
+    }
+    return parsed;
+}
@@ -2,15 +2,28 @@
 
 #include <QApplication>
 #include <QDesktopWidget>
+#include <QHelpEvent>
+#include <QToolTip>
 
+#include "datetimepopuppool.h"
 #include "styleresourcepool.h"
 #include "iconfont/iconwidget.h"
 
 DateTimeEdit::DateTimeEdit(QWidget* parent, DateTimeEdit::DateEditType type, int year, int month)
     : QFrame(parent)
+    , popup_widget_(nullptr)
+    , picker_(nullptr)
+    , range_picker_(nullptr)
+    , popup_shared_(false)
+    , min_date_(QDate(year - 100, 1, 1))
+    , max_date_(QDate(year + 100, 1, 1).addDays(-1))
     , type_(type)
+    , perf_counters_(nullptr)
 {
     setObjectName("date_time_edit");
+#ifdef DATETIMEEDIT_PROFILING
+    perf_counters_ = new PerfCounters;
+#endif
 
     setFixedHeight(32);
     setMinimumWidth(240);
@@ -39,20 +52,14 @@ DateTimeEdit::DateTimeEdit(QWidget* parent, DateTimeEdit::DateEditType type, int
     calendar_btn->setFixedSize(16, 16);
     calendar_btn->setToolTip(GET_TXT("IDCS_CALENDAR"));
 
-    popup_widget_ = new QFrame(this);
-    popup_widget_->setWindowFlags(Qt::Popup | Qt::NoDropShadowWindowHint);
-    popup_widget_->hide();
-
     switch (type) {
     case DateTimeEdit::kDateTime: {
         start_edit_->setMinimumWidth(140);
-        popup_widget_->setFixedSize(215, 261);
         split_label->hide();
         end_edit_->hide();
         break;
     }
     case DateTimeEdit::kDate: {
-        popup_widget_->setFixedSize(215, 230);
         split_label->hide();
         end_edit_->hide();
         break;
@@ -60,38 +67,17 @@ DateTimeEdit::DateTimeEdit(QWidget* parent, DateTimeEdit::DateEditType type, int
     case DateTimeEdit::kDateTimeRange: {
         start_edit_->setMinimumWidth(140);
         end_edit_->setMinimumWidth(140);
-        popup_widget_->setFixedSize(426, 286);
         break;
     }
     case DateTimeEdit::kDateRange: {
         start_edit_->setMinimumWidth(73);
         end_edit_->setMinimumWidth(73);
-        popup_widget_->setFixedSize(426, 254);
         break;
     }
     default:
         break;
     }
 
-    stacked_layout_ = new QStackedLayout(popup_widget_);
-    stacked_layout_->setMargin(0);
-
-    date_time_picker_ = new DateTimePicker(this, year, month);
-    date_picker_ = new DatePicker(this, year, month);
-    date_time_range_picker_ = new DateTimeRangePicker(this, year, month);
-    date_range_picker_ = new DateRangePicker(this, year, month);
-
-    stacked_layout_->insertWidget(kDateTime, date_time_picker_);
-    stacked_layout_->insertWidget(kDate, date_picker_);
-    stacked_layout_->insertWidget(kDateTimeRange, date_time_range_picker_);
-    stacked_layout_->insertWidget(kDateRange, date_range_picker_);
-    stacked_layout_->setCurrentIndex(type);
-
-    date_time_picker_->installEventFilter(this);
-    date_picker_->installEventFilter(this);
-    date_time_range_picker_->installEventFilter(this);
-    date_range_picker_->installEventFilter(this);
-
     auto edit_layout = new QHBoxLayout(edit_widget);
     edit_layout->setMargin(0);
     edit_layout->addWidget(start_edit_);
@@ -107,6 +93,7 @@ DateTimeEdit::DateTimeEdit(QWidget* parent, DateTimeEdit::DateEditType type, int
     main_layout->addSpacing(8);
     main_layout->addWidget(calendar_btn);
 
+    applyDateLimits();
     initDateFormat(type, year, month);
 
     // źŲ
@@ -118,54 +105,103 @@ DateTimeEdit::DateTimeEdit(QWidget* parent, DateTimeEdit::DateEditType type, int
     connect(end_edit_, &SimpleDateTimeEdit::dateTimeChanged, this, &DateTimeEdit::dateTimeChanged);
 
     connect(calendar_btn, &QPushButton::clicked, this, &DateTimeEdit::editBtnClicked);
+}
 
-    connect(date_time_picker_, &DateTimePicker::timeChanged, this, &DateTimeEdit::timeChanged);
-    connect(date_time_picker_, &DateTimePicker::dateChanged, this, &DateTimeEdit::dateChanged);
-    connect(date_picker_, &DateTimePicker::dateChanged, this, &DateTimeEdit::dateChanged);
-
-    connect(date_time_range_picker_, &DateTimeRangePicker::timeRangeChanged, this, &DateTimeEdit::timeRangeChanged);
-    connect(date_time_range_picker_, &DateTimeRangePicker::dateRangeChanged, this, &DateTimeEdit::dateRangeChanged);
-    connect(date_range_picker_, &DateTimeRangePicker::dateRangeChanged, this, &DateTimeEdit::dateRangeChanged);
+DateTimeEdit::~DateTimeEdit()
+{
+#ifdef DATETIMEEDIT_PROFILING
+    delete perf_counters_;
+#endif
 }
 
 void DateTimeEdit::setDate(const QDate& date)
 {
-    if (type_ == kDateTime)
-        date_time_picker_->setDateTime(QDateTime(date));
-    else if (type_ == kDate)
-        date_picker_->setDateTime(QDateTime(date));
+    setDateTime(QDateTime(date));
 }
 
 void DateTimeEdit::setDateTime(const QDateTime& date_time)
 {
-    if (type_ == kDateTime)
-        date_time_picker_->setDateTime(date_time);
-    else if (type_ == kDate)
-        date_picker_->setDateTime(date_time);
+    if (type_ != kDateTime && type_ != kDate)
+        return;
+
+    // ༭ֵ仯dateTimeChanged()µǰֵͬѡ
+    start_edit_->setDateTime(date_time);
 }
 
 void DateTimeEdit::setStartDateTime(const QDateTime& start)
 {
-    if (stacked_layout_->currentIndex() == kDateTimeRange)
-        date_time_range_picker_->setStartDateTime(start);
-    else if (stacked_layout_->currentIndex() == kDateRange)
-        date_range_picker_->setStartDateTime(start);
+    if (type_ != kDateTimeRange && type_ != kDateRange)
+        return;
+
+    start_edit_->setDateTime(start);
 }
 
 void DateTimeEdit::setEndDateTime(const QDateTime& end)
 {
-    if (stacked_layout_->currentIndex() == kDateTimeRange)
-        date_time_range_picker_->setEndDateTime(end);
-    else if (stacked_layout_->currentIndex() == kDateRange)
-        date_range_picker_->setEndDateTime(end);
+    if (type_ != kDateTimeRange && type_ != kDateRange)
+        return;
+
+    end_edit_->setDateTime(end);
 }
 
 void DateTimeEdit::setDateTimeRange(const QDateTime& start, const QDateTime& end)
 {
-    if (stacked_layout_->currentIndex() == kDateTimeRange)
-        date_time_range_picker_->setDateTimeRange(start, end);
-    else if (stacked_layout_->currentIndex() == kDateRange)
-        date_range_picker_->setDateTimeRange(start, end);
+    if (type_ != kDateTimeRange && type_ != kDateRange)
+        return;
+
+    if (start > end)
+        return;
+
+    start_edit_->setDateTime(start);
+    end_edit_->setDateTime(end);
+}
+
+void DateTimeEdit::setPopupShared(bool shared)
+{
+    if (popup_shared_ == shared)
+        return;
+
+    // л´δ򿪵ʱ´
+    if (popup_widget_) {
+        popup_widget_->hide();
+        if (popup_shared_) {
+            unbindPicker();
+        } else {
+            auto popup = popup_widget_;
+            unbindPicker();
+            popup->deleteLater();
+        }
+    }
+
+    popup_shared_ = shared;
+}
+
+void DateTimeEdit::setMinDate(const QDate& date)
+{
+    if (!date.isValid() || date == min_date_)
+        return;
+
+    min_date_ = date;
+    applyDateLimits();
+}
+
+void DateTimeEdit::setMaxDate(const QDate& date)
+{
+    if (!date.isValid() || date == max_date_)
+        return;
+
+    max_date_ = date;
+    applyDateLimits();
+}
+
+void DateTimeEdit::setSpecialDate(const QList<QDate>& dates)
+{
+    special_dates_ = dates;
+
+    if (picker_)
+        picker_->setSpecialDate(special_dates_);
+    else if (range_picker_)
+        range_picker_->setSpecialDate(special_dates_);
 }
 
 void DateTimeEdit::resetDateTime()
@@ -173,83 +209,73 @@ void DateTimeEdit::resetDateTime()
     auto start = QDateTime(QDate::currentDate(), QTime(0, 0, 0));
     auto end = QDateTime(QDate::currentDate(), QTime(23, 59, 59));
 
-    if (stacked_layout_->currentIndex() == kDateTimeRange)
-        date_time_range_picker_->setDateTimeRange(start, end);
-    else if (stacked_layout_->currentIndex() == kDateRange)
-        date_range_picker_->setDateTimeRange(start, end);
+    setDateTimeRange(start, end);
 }
 
 QDate DateTimeEdit::date()
 {
-    if (stacked_layout_->currentIndex() == kDateTime)
-        return date_time_picker_->date();
-    else if (stacked_layout_->currentIndex() == kDate)
-        return date_picker_->date();
+    if (type_ != kDateTime && type_ != kDate)
+        return QDate();
 
-    return QDate();
+    return start_date_time_.date();
 }
 
 QList<QDate> DateTimeEdit::selected_date()
 {
-    if (stacked_layout_->currentIndex() == kDateTime)
-        return date_time_picker_->selected_date();
-    else if (stacked_layout_->currentIndex() == kDate)
-        return date_picker_->selected_date();
+    if (type_ != kDateTime && type_ != kDate)
+        return QList<QDate>();
 
-    return QList<QDate>();
+    return picker_ ? picker_->selected_date() : QList<QDate>{date()};
 }
 
 QTime DateTimeEdit::time()
 {
-    auto picker = stacked_layout_->currentIndex() == kDateTime ? date_time_picker_ : date_picker_;
-    return picker->time();
-}
+    if (type_ != kDateTime && type_ != kDate)
+        return QTime();
 
-QDateTime DateTimeEdit::start_date_time()
-{
-    return QDateTime::fromString(real_text_.split(" ~ ").at(0), date_format_);
-}
-
-QDateTime DateTimeEdit::end_date_time()
-{
-    return QDateTime::fromString(real_text_.split(" ~ ").at(1), date_format_);
+    return start_date_time_.time();
 }
 
 bool DateTimeEdit::isValidDateTimeRange()
 {
-    auto range = real_text_.split(" ~ ");
-    return QDateTime::fromString(range.at(0), date_format_) <= QDateTime::fromString(range.at(1), date_format_);
+    return start_date_time_ <= end_date_time_;
 }
 
 bool DateTimeEdit::isDifferentYearOrMonth()
 {
-    auto range = real_text_.split(" ~ ");
-    auto start_date = QDateTime::fromString(range.at(0), date_format_).date();
-    auto end_date = QDateTime::fromString(range.at(1), date_format_).date();
+    QDate start_date = start_date_time_.date();
+    QDate end_date = end_date_time_.date();
 
     return start_date.year() != end_date.year() || start_date.month() != end_date.month();
 }
 
-void DateTimeEdit::resizeEvent(QResizeEvent* event)
+bool DateTimeEdit::event(QEvent* event)
 {
-    setToolTip(real_text_);
+    // ʾıʾʱŸʽ
+    if (event->type() == QEvent::ToolTip) {
+        auto help_event = static_cast<QHelpEvent*>(event);
+        QToolTip::showText(help_event->globalPos(), displayText(), this);
+        return true;
+    }
+
+    return QFrame::event(event);
 }
 
 bool DateTimeEdit::eventFilter(QObject* watched, QEvent* event)
 {
     if (auto const picker = qobject_cast<DateTimeRangePicker*>(watched)) {
         if (event->type() == QEvent::Show) {
-            auto range = real_text_.split(" ~ ");
-            auto start_date_time = QDateTime::fromString(range.at(0), date_format_);
-            auto end_date_time = QDateTime::fromString(range.at(1), date_format_);
-            picker->setDateTimeRange(start_date_time, end_date_time);
+            PERF_SCOPE(perf_counters_, kPickerSync);
+
+            picker->setDateTimeRange(start_date_time_, end_date_time_);
         }
     }
 
     if (auto const picker = qobject_cast<DateTimePicker*>(watched)) {
         if (event->type() == QEvent::Show) {
-            auto date_time = QDateTime::fromString(real_text_, date_format_);
-            picker->setDateTime(date_time);
+            PERF_SCOPE(perf_counters_, kPickerSync);
+
+            picker->setDateTime(start_date_time_);
         }
     }
 
@@ -291,26 +317,38 @@ void DateTimeEdit::dateTimeChanged(const QDateTime& date_time)
         return;
 
     if (type_ == kDateTime || type_ == kDate) {
-        real_text_ = date_time.toString(date_format_);
-        setDateTime(date_time);
+        start_date_time_ = normalized(date_time);
+        if (picker_)
+            picker_->setDateTime(start_date_time_);
     } else {
         if (simple_edit == start_edit_) {
-            auto end_text = real_text_.split(" ~ ").at(1);
-
-            real_text_ = date_time.toString(date_format_) + " ~ " + end_text;
-            setStartDateTime(date_time);
+            start_date_time_ = normalized(date_time);
+            if (range_picker_)
+                range_picker_->setStartDateTime(start_date_time_);
         } else {
-            auto startText = real_text_.split(" ~ ").at(0);
-            real_text_ = startText + " ~ " + date_time.toString(date_format_);
+            end_date_time_ = normalized(date_time);
+            if (range_picker_)
+                range_picker_->setEndDateTime(end_date_time_);
+        }
 
-            setEndDateTime(date_time);
+        // ѡdateRangeChanged()
+        if (!range_picker_) {
+            emit startDateTimeChanged(start_date_time_);
+            emit endDateTimeChanged(end_date_time_);
         }
     }
 }
 
 void DateTimeEdit::editBtnClicked()
 {
-    if (popup_widget_->isHidden()) {
+    if (!popup_widget_ || popup_widget_->isHidden()) {
+        PERF_SCOPE(perf_counters_, kPopupOpen);
+
+        if (popup_shared_)
+            bindSharedPopup();
+        else
+            ensurePicker();
+
         QPoint pos = mapToGlobal(QPoint(0, 0));
         pos.setY(pos.y() + height() + 8);
 
@@ -335,13 +373,10 @@ void DateTimeEdit::timeChanged(const QTime& time)
     if (!widget)
         return;
 
-    auto date_time = QDateTime::fromString(real_text_, date_format_);
-    date_time.setTime(time);
+    PERF_SCOPE(perf_counters_, kPickerSync);
 
-    real_text_ = date_time.toString(date_format_);
-
-    start_edit_->setDateTime(date_time);
-    setToolTip(real_text_);
+    start_date_time_.setTime(time);
+    start_edit_->setDateTime(start_date_time_);
 }
 
 void DateTimeEdit::dateChanged(const QDate& date)
@@ -350,13 +385,10 @@ void DateTimeEdit::dateChanged(const QDate& date)
     if (!widget)
         return;
 
-    auto date_time = QDateTime::fromString(real_text_, date_format_);
-    date_time.setDate(date);
+    PERF_SCOPE(perf_counters_, kPickerSync);
 
-    real_text_ = date_time.toString(date_format_);
-
-    start_edit_->setDateTime(date_time);
-    setToolTip(real_text_);
+    start_date_time_.setDate(date);
+    start_edit_->setDateTime(start_date_time_);
 }
 
 void DateTimeEdit::timeRangeChanged()
@@ -365,113 +397,259 @@ void DateTimeEdit::timeRangeChanged()
     if (!widget)
         return;
 
-    auto range = real_text_.split(" ~ ");
-    auto start = QDateTime::fromString(range.at(0), date_format_);
-    auto end = QDateTime::fromString(range.at(1), date_format_);
-    start.setTime(widget->timeRange().first);
-    end.setTime(widget->timeRange().second);
+    PERF_SCOPE(perf_counters_, kPickerSync);
 
-    real_text_ = start.toString(date_format_) + " ~ " + end.toString(date_format_);
+    auto time_range = widget->timeRange();
+    start_date_time_.setTime(time_range.first);
+    end_date_time_.setTime(time_range.second);
 
-    start_edit_->setDateTime(start_date_time());
-    end_edit_->setDateTime(end_date_time());
-    setToolTip(real_text_);
+    start_edit_->setDateTime(start_date_time_);
+    end_edit_->setDateTime(end_date_time_);
 
-    emit startDateTimeChanged(start);
-    emit endDateTimeChanged(end);
+    emit startDateTimeChanged(start_date_time_);
+    emit endDateTimeChanged(end_date_time_);
 }
+
 void DateTimeEdit::dateRangeChanged()
 {
     auto widget = qobject_cast<DateTimeRangePicker*>(sender());
     if (!widget)
         return;
 
-    auto range = real_text_.split(" ~ ");
-    auto start = QDateTime::fromString(range.at(0), date_format_);
-    auto end = QDateTime::fromString(range.at(1), date_format_);
-    start.setDate(widget->dateRange().first);
-    end.setDate(widget->dateRange().second);
+    PERF_SCOPE(perf_counters_, kPickerSync);
 
-    real_text_ = start.toString(date_format_) + " ~ " + end.toString(date_format_);
+    auto date_range = widget->dateRange();
+    start_date_time_.setDate(date_range.first);
+    end_date_time_.setDate(date_range.second);
 
-    start_edit_->setDateTime(start_date_time());
-    end_edit_->setDateTime(end_date_time());
+    start_edit_->setDateTime(start_date_time_);
+    end_edit_->setDateTime(end_date_time_);
 
-    setToolTip(real_text_);
-
-    emit startDateTimeChanged(start);
-    emit endDateTimeChanged(end);
+    emit startDateTimeChanged(start_date_time_);
+    emit endDateTimeChanged(end_date_time_);
 }
 
 void DateTimeEdit::initDateFormat(DateEditType type, int year, int month)
 {
-    // QString date_fm
-    // QString date_time_fm;
-
     auto current_day = QDateTime::currentDateTime().date().day();
-    auto init_date_time = QDateTime(QDate(year, month, current_day), QTime());
+    auto init_date_time = QDateTime(QDate(year, month, current_day), QTime(0, 0, 0));
 
     switch (type) {
     case DateTimeEdit::kDateTime: {
         date_format_ = "yyyy-MM-dd hh:mm:ss";
-        QString date_time = init_date_time.toString(date_format_);
 #ifdef APP_PLATFORM
         date_format_ = date_timeFm;
-        date_time = init_date_time.toString(date_format_);
 #endif
-        real_text_ = date_time;
+        start_date_time_ = init_date_time;
         break;
     }
     case DateTimeEdit::kDate: {
         date_format_ = "yyyy-MM-dd";
-        QString date = init_date_time.toString("yyyy-MM-dd");
 #ifdef APP_PLATFORM
         date_format_ = dateFm;
-        date = init_date_time.toString(dateFm);
 #endif
-        real_text_ = date;
+        start_date_time_ = init_date_time;
         break;
     }
     case DateTimeEdit::kDateTimeRange: {
         date_format_ = "yyyy-MM-dd hh:mm:ss";
-        QString start_date_time = init_date_time.toString(date_format_);
-        QString end_date_time = init_date_time.addDays(1).addMSecs(-1).toString(date_format_);
 #ifdef APP_PLATFORM
         date_format_ = date_timeFm;
-        start_date_time = init_date_time.toString(date_format_);
-        end_date_time = init_date_time.addDays(1).addSecs(-1).toString(date_format_);
 #endif
-        real_text_ = start_date_time + " ~ " + end_date_time;
+        start_date_time_ = init_date_time;
+        end_date_time_ = init_date_time.addDays(1).addSecs(-1);
         break;
     }
     case DateTimeEdit::kDateRange: {
-        auto first_day_in_month = QDateTime(QDate(year, month, 1), QTime());
         date_format_ = "yyyy-MM-dd";
-        QString start_date = first_day_in_month.toString(date_format_);
-        QString end_date = init_date_time.toString(date_format_);
 #ifdef APP_PLATFORM
         date_format_ = dateFm;
-        start_date = first_day_in_month.toString(date_format_);
-        end_date = init_date_time.toString(date_format_);
 #endif
-        real_text_ = start_date + " ~ " + end_date;
+        start_date_time_ = QDateTime(QDate(year, month, 1), QTime(0, 0, 0));
+        end_date_time_ = init_date_time;
         break;
     }
     default:
         break;
     }
 
+    codec_ = DateTimeCodec(date_format_);
     start_edit_->setDisplayFormat(date_format_);
     end_edit_->setDisplayFormat(date_format_);
 
-    if (real_text_.contains("~")) {
-        start_edit_->setDateTime(start_date_time());
-        end_edit_->setDateTime(end_date_time());
-    } else {
-        start_edit_->setDateTime(QDateTime(date(), time()));
+    start_date_time_ = normalized(start_date_time_);
+    end_date_time_ = normalized(end_date_time_);
+    start_edit_->setDateTime(start_date_time_);
+    if (type == kDateTimeRange || type == kDateRange)
+        end_edit_->setDateTime(end_date_time_);
+}
+
+QDateTime DateTimeEdit::normalized(const QDateTime& date_time) const
+{
+    // ڿѡڷΧ, ʱȡ߽ڵʼʱ
+    QDate date = qBound(min_date_, date_time.date(), max_date_);
+    QTime time = date_time.time();
+    if (date != date_time.date())
+        time = date == min_date_ ? QTime(0, 0, 0) : QTime(23, 59, 59);
+
+    // ʾʽľһ: ʽûеʱ֡0, 0
+    QDateTimeEdit::Sections sections = start_edit_->displayedSections();
+    int hour = (sections & QDateTimeEdit::HourSection) ? time.hour() : 0;
+    int minute = (sections & QDateTimeEdit::MinuteSection) ? time.minute() : 0;
+    int second = (sections & QDateTimeEdit::SecondSection) ? time.second() : 0;
+    return QDateTime(date, QTime(hour, minute, second));
+}
+
+QString DateTimeEdit::displayText() const
+{
+    if (type_ == kDateTimeRange || type_ == kDateRange)
+        return codec_.toString(start_date_time_) + " ~ " + codec_.toString(end_date_time_);
+
+    return codec_.toString(start_date_time_);
+}
+
+QFrame* DateTimeEdit::createPopup(QWidget* parent, DateEditType type)
+{
+    auto popup = new QFrame(parent);
+    popup->setWindowFlags(Qt::Popup | Qt::NoDropShadowWindowHint);
+    popup->hide();
+
+    switch (type) {
+    case DateTimeEdit::kDateTime:
+        popup->setFixedSize(215, 261);
+        break;
+    case DateTimeEdit::kDate:
+        popup->setFixedSize(215, 230);
+        break;
+    case DateTimeEdit::kDateTimeRange:
+        popup->setFixedSize(426, 286);
+        break;
+    case DateTimeEdit::kDateRange:
+        popup->setFixedSize(426, 254);
+        break;
+    default:
+        break;
     }
 
-    setToolTip(real_text_);
+    auto layout = new QVBoxLayout(popup);
+    layout->setMargin(0);
+
+    return popup;
+}
+
+QWidget* DateTimeEdit::createPicker(QFrame* popup)
+{
+    QWidget* picker = nullptr;
+    switch (type_) {
+    case DateTimeEdit::kDateTime:
+    case DateTimeEdit::kDate: {
+        QDate date = this->date().isValid() ? this->date() : QDate::currentDate();
+        if (type_ == kDateTime)
+            picker = new DateTimePicker(popup, date.year(), date.month());
+        else
+            picker = new DatePicker(popup, date.year(), date.month());
+        break;
+    }
+    case DateTimeEdit::kDateTimeRange:
+    case DateTimeEdit::kDateRange: {
+        QDate date = start_date_time().date().isValid() ? start_date_time().date() : QDate::currentDate();
+        if (type_ == kDateTimeRange)
+            picker = new DateTimeRangePicker(popup, date.year(), date.month());
+        else
+            picker = new DateRangePicker(popup, date.year(), date.month());
+        break;
+    }
+    default:
+        return nullptr;
+    }
+
+    popup->layout()->addWidget(picker);
+    return picker;
+}
+
+void DateTimeEdit::ensurePicker()
+{
+    if (popup_widget_)
+        return;
+
+    auto popup = createPopup(this, type_);
+    bindPicker(popup, createPicker(popup));
+}
+
+void DateTimeEdit::bindSharedPopup()
+{
+    DateTimePopupPool::Slot& slot = DateTimePopupPool::forWindow(window())->slot(type_);
+    if (slot.owner == this && popup_widget_ == slot.popup)
+        return;
+
+    // Ƶ, Ƚԭڵİ
+    if (popup_widget_)
+        unbindPicker();
+
+    if (!slot.popup) {
+        slot.popup = createPopup(window(), type_);
+        slot.picker = createPicker(slot.popup);
+    }
+
+    if (slot.owner)
+        slot.owner->unbindPicker();
+
+    bindPicker(slot.popup, slot.picker);
+    slot.owner = this;
+}
+
+void DateTimeEdit::bindPicker(QFrame* popup, QWidget* picker)
+{
+    popup_widget_ = popup;
+    picker_ = qobject_cast<DateTimePicker*>(picker);
+    range_picker_ = qobject_cast<DateTimeRangePicker*>(picker);
+
+    if (picker_) {
+        connect(picker_, &DateTimePicker::timeChanged, this, &DateTimeEdit::timeChanged);
+        connect(picker_, &DateTimePicker::dateChanged, this, &DateTimeEdit::dateChanged);
+        picker_->setSpecialDate(special_dates_);
+    } else if (range_picker_) {
+        connect(range_picker_, &DateTimeRangePicker::timeRangeChanged, this, &DateTimeEdit::timeRangeChanged);
+        connect(range_picker_, &DateTimeRangePicker::dateRangeChanged, this, &DateTimeEdit::dateRangeChanged);
+        range_picker_->setSpecialDate(special_dates_);
+    }
+    applyDateLimits();
+
+    // ʾʱeventFilter()ͬ༭ֵ
+    if (picker)
+        picker->installEventFilter(this);
+}
+
+void DateTimeEdit::unbindPicker()
+{
+    QWidget* picker = picker_ ? static_cast<QWidget*>(picker_) : range_picker_;
+    if (picker) {
+        disconnect(picker, nullptr, this, nullptr);
+        picker->removeEventFilter(this);
+    }
+
+    // ǹ, ༭ʱ༭֮İ(ĸΪڴ)
+    if (popup_shared_ && popup_widget_ && popup_widget_->parentWidget()) {
+        DateTimePopupPool::Slot& slot = DateTimePopupPool::forWindow(popup_widget_->parentWidget())->slot(type_);
+        if (slot.owner == this)
+            slot.owner = nullptr;
+    }
+
+    popup_widget_ = nullptr;
+    picker_ = nullptr;
+    range_picker_ = nullptr;
+}
+
+void DateTimeEdit::applyDateLimits()
+{
+    // ༭ͬڿѡΧ, ʱɱ༭, dateTimeChanged()µǰֵ
+    start_edit_->setDateRange(min_date_, max_date_);
+    end_edit_->setDateRange(min_date_, max_date_);
+
+    if (picker_)
+        picker_->setDateLimits(min_date_, max_date_);
+    else if (range_picker_)
+        range_picker_->setDateLimits(min_date_, max_date_);
 }
 
 void DateTimeEdit::setCursorPosInVisivle(SimpleDateTimeEdit* simple_edit, int index)
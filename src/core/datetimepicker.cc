@@ -42,6 +42,23 @@ QDateTime DateTimePicker::dateTime()
     return QDateTime(calendar_widget_->selected_date().at(0), time_edit_->time());
 }
 
+// ȷſս, м״̬Сڴ
+static void setCalendarDateLimits(CalendarWidget* calendar, const QDate& min_date, const QDate& max_date)
+{
+    if (min_date > calendar->max_date()) {
+        calendar->setMaxDate(max_date);
+        calendar->setMinDate(min_date);
+    } else {
+        calendar->setMinDate(min_date);
+        calendar->setMaxDate(max_date);
+    }
+}
+
+void DateTimePicker::setDateLimits(const QDate& min_date, const QDate& max_date)
+{
+    setCalendarDateLimits(calendar_widget_, min_date, max_date);
+}
+
 void DateTimePicker::calendarSelectionChanged()
 {
     if (calendar_widget_->selected_date().isEmpty())
@@ -107,6 +124,9 @@ DateTimeRangePicker::DateTimeRangePicker(QWidget* parent, int year, int month)
     connect(end_calendar_, &CalendarWidget::calendarSelectionChanged, this, &DateTimeRangePicker::dateRangeChanged);
     connect(start_calendar_, &CalendarWidget::dateDoubleClicked, this, &DateTimeRangePicker::dateDoubleClicked);
     connect(end_calendar_, &CalendarWidget::dateDoubleClicked, this, &DateTimeRangePicker::dateDoubleClicked);
+    // ˫Χ, ȴ˫
+    start_calendar_->setClickCommitMode(CalendarTable::kSpeculativeCommit);
+    end_calendar_->setClickCommitMode(CalendarTable::kSpeculativeCommit);
     connect(start_time_edit_, &QTimeEdit::timeChanged, this, &DateTimeRangePicker::timeChanged);
     connect(end_time_edit_, &QTimeEdit::timeChanged, this, &DateTimeRangePicker::timeChanged);
 
@@ -170,6 +190,18 @@ QPair<QDate, QDate> DateTimeRangePicker::dateRange()
     return date_range_pair_;
 }
 
+void DateTimeRangePicker::setDateLimits(const QDate& min_date, const QDate& max_date)
+{
+    setCalendarDateLimits(start_calendar_, min_date, max_date);
+    setCalendarDateLimits(end_calendar_, min_date, max_date);
+}
+
+void DateTimeRangePicker::setSpecialDate(const QList<QDate>& dates)
+{
+    start_calendar_->setSpecialDate(dates);
+    end_calendar_->setSpecialDate(dates);
+}
+
 void DateTimeRangePicker::calendarSelectionAdded(const QDate& date)
 {
     disconnectSelectionAdded();
@@ -272,7 +304,7 @@ void DateTimeRangePicker::paintEvent(QPaintEvent* /*event*/)
 
     painter.save();
 
-    painter.setPen(QPen(GET_COLOR("normal_pop_border"), 1));
+    painter.setPen(QPen(GET_COLOR(StyleResourcePool::kNormalPopBorder), 1));
     painter.drawRect(rect().adjusted(1, 1, -1, -1));
     painter.drawLine(width() / 2, 1, width() / 2, height() - 1);
 
@@ -292,6 +324,10 @@ void DateTimeRangePicker::refreshCalendarSelection()
 
     addSelectedDate(date_range_pair_.first, start_calendar_);
     addSelectedDate(date_range_pair_.second, end_calendar_);
+
+    // ʾΧ, ¡ʱҲ
+    start_calendar_->setRangeBand(date_range_pair_.first, date_range_pair_.second);
+    end_calendar_->setRangeBand(date_range_pair_.first, date_range_pair_.second);
 }
 
 void DateTimeRangePicker::connectSelectionAdded()
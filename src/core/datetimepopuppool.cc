@@ -0,0 +1,21 @@
+#include "datetimepopuppool.h"
+
+DateTimePopupPool::DateTimePopupPool(QWidget* window)
+    : QObject(window)
+{
+    setObjectName("date_time_popup_pool");
+
+    for (auto& slot : slots_) {
+        slot.popup = nullptr;
+        slot.picker = nullptr;
+    }
+}
+
+DateTimePopupPool* DateTimePopupPool::forWindow(QWidget* window)
+{
+    auto pool = window->findChild<DateTimePopupPool*>(QString(), Qt::FindDirectChildrenOnly);
+    if (!pool)
+        pool = new DateTimePopupPool(window);
+
+    return pool;
+}
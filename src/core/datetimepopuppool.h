@@ -0,0 +1,35 @@
+#ifndef DATETIMEPOPUPPOOL_H_
+#define DATETIMEPOPUPPOOL_H_
+
+#include <QFrame>
+#include <QPointer>
+
+#include "datetimeedit.h"
+
+/**
+ * @brief ͬһ㴰ڹڵÿֱ༭һѡ
+ * ʱ󶨵ӦDateTimeEdit, Ϊ㴰ڵӶ洰
+ */
+class DateTimePopupPool : public QObject
+{
+    Q_OBJECT
+public:
+    struct Slot
+    {
+        QFrame* popup;
+        QWidget* picker;
+        QPointer<DateTimeEdit> owner; // ǰ󶨵ı༭
+    };
+
+    static DateTimePopupPool* forWindow(QWidget* window);
+
+    Slot& slot(DateTimeEdit::DateEditType type) { return slots_[type]; }
+
+private:
+    explicit DateTimePopupPool(QWidget* window);
+
+private:
+    Slot slots_[DateTimeEdit::kDateRange + 1];
+};
+
+#endif // DATETIMEPOPUPPOOL_H_
@@ -0,0 +1,77 @@
+#include "daychangenotifier.h"
+
+#include <QGuiApplication>
+#include <QPointer>
+
+namespace {
+
+// ʱڼܲʱ, ޸ϵͳʱҲӰĶʱ, ˶ڸ
+constexpr int kMaxCheckInterval = 60 * 1000;
+// ӳ, ⶨʱ紥ʱδ仯
+constexpr int kMidnightSlack = 500;
+
+} // namespace
+
+DayChangeNotifier::DayChangeNotifier(QObject* parent)
+    : QObject(parent)
+    , timer_(new QTimer(this))
+{
+    timer_->setSingleShot(true);
+    connect(timer_, &QTimer::timeout, this, &DayChangeNotifier::check);
+
+    // лָ¼ʱ
+    if (auto app = qobject_cast<QGuiApplication*>(QCoreApplication::instance())) {
+        connect(app, &QGuiApplication::applicationStateChanged, this, [this](Qt::ApplicationState state) {
+            if (state == Qt::ApplicationActive)
+                check();
+        });
+    }
+
+    QDateTime current = now();
+    today_ = current.date();
+    schedule(current);
+}
+
+DayChangeNotifier* DayChangeNotifier::Instance()
+{
+    // ΪQCoreApplicationӶ, ʱӦһ
+    static QPointer<DayChangeNotifier> obj;
+    if (!obj)
+        obj = new DayChangeNotifier(QCoreApplication::instance());
+
+    return obj;
+}
+
+void DayChangeNotifier::setClock(const Clock& clock)
+{
+    clock_ = clock;
+    check();
+}
+
+void DayChangeNotifier::check()
+{
+    QDateTime current = now();
+    QDate day = current.date();
+
+    if (day != today_) {
+        QDate old_day = today_;
+        today_ = day;
+        emit dayChanged(old_day, day);
+    }
+
+    schedule(current);
+}
+
+void DayChangeNotifier::schedule(const QDateTime& now)
+{
+    QDate tomorrow = now.date().addDays(1);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    QDateTime midnight = tomorrow.startOfDay();
+#else
+    QDateTime midnight(tomorrow, QTime(0, 0, 0));
+#endif
+
+    // ʱлʱ, 00:00ܲ(Ч), ʱ
+    qint64 to_midnight = midnight.isValid() ? now.msecsTo(midnight) + kMidnightSlack : kMaxCheckInterval;
+    timer_->start(int(qBound<qint64>(kMidnightSlack, to_midnight, kMaxCheckInterval)));
+}
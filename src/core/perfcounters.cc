@@ -0,0 +1,68 @@
+#include "perfcounters.h"
+
+#ifdef DATETIMEEDIT_PROFILING
+
+Q_LOGGING_CATEGORY(lcDateTimeEditPerf, "datetimeedit.perf")
+
+PerfCounters::PerfCounters()
+{
+    reset();
+}
+
+void PerfCounters::record(Probe probe, qint64 ns)
+{
+    Stat& stat = stats_[probe];
+    ++stat.count;
+    stat.total_ns += ns;
+    stat.max_ns = qMax(stat.max_ns, ns);
+
+    // ԪƹƵ, ֻ
+    if (probe != kCellPaint) {
+        qCDebug(lcDateTimeEditPerf, "%s: %.1f us", probeName(probe), ns / 1000.0);
+    }
+}
+
+void PerfCounters::reset()
+{
+    for (auto& stat : stats_) {
+        stat.count = 0;
+        stat.total_ns = 0;
+        stat.max_ns = 0;
+    }
+}
+
+QString PerfCounters::report() const
+{
+    QString text;
+    for (int i = 0; i < kProbeCount; ++i) {
+        const Stat& stat = stats_[i];
+        text += QString("%1: count %2, avg %3 us, max %4 us\n")
+                    .arg(probeName(Probe(i)))
+                    .arg(stat.count)
+                    .arg(stat.averageNs() / 1000.0, 0, 'f', 1)
+                    .arg(stat.max_ns / 1000.0, 0, 'f', 1);
+    }
+    return text;
+}
+
+const char* PerfCounters::probeName(Probe probe)
+{
+    switch (probe) {
+    case kRefreshCalendar:
+        return "refreshCalendar";
+    case kRefreshSelection:
+        return "refreshSelection";
+    case kRefreshSpecialDate:
+        return "refreshSpecialDate";
+    case kCellPaint:
+        return "cellPaint";
+    case kPopupOpen:
+        return "popupOpen";
+    case kPickerSync:
+        return "pickerSync";
+    default:
+        return "unknown";
+    }
+}
+
+#endif // DATETIMEEDIT_PROFILING
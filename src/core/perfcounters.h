@@ -0,0 +1,88 @@
+#ifndef PERFCOUNTERS_H_
+#define PERFCOUNTERS_H_
+
+// й̶һPerfCounters*Ա(δʱΪnullptr), ĲǷ޹
+class PerfCounters;
+
+#ifdef DATETIMEEDIT_PROFILING
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QString>
+
+#include "datetimeedit_global.h"
+
+// κʱ, ʽ: QT_LOGGING_RULES="datetimeedit.perf.debug=true"
+Q_DECLARE_LOGGING_CATEGORY(lcDateTimeEditPerf)
+
+/**
+ * @brief ܼ·¼ôۼƺʱŲ鵯
+ * ڿCMakeѡDATETIMEEDIT_PROFILINGʱ, δʱֻյPERF_SCOPE, κο
+ */
+class DATETIMEEDIT_EXPORT PerfCounters
+{
+public:
+    enum Probe
+    {
+        kRefreshCalendar,
+        kRefreshSelection,
+        kRefreshSpecialDate,
+        kCellPaint,
+        kPopupOpen,
+        kPickerSync,
+        kProbeCount
+    };
+
+    struct Stat
+    {
+        quint64 count;
+        qint64 total_ns;
+        qint64 max_ns;
+
+        qint64 averageNs() const { return count ? total_ns / qint64(count) : 0; }
+    };
+
+    PerfCounters();
+
+    void record(Probe probe, qint64 ns);
+    const Stat& stat(Probe probe) const { return stats_[probe]; }
+    void reset();
+
+    // ÿ·һ: ơƽʱ
+    QString report() const;
+    static const char* probeName(Probe probe);
+
+private:
+    Stat stats_[kProbeCount];
+};
+
+class PerfScope
+{
+public:
+    PerfScope(PerfCounters* counters, PerfCounters::Probe probe)
+        : counters_(counters)
+        , probe_(probe)
+    {
+        timer_.start();
+    }
+    ~PerfScope()
+    {
+        if (counters_)
+            counters_->record(probe_, timer_.nsecsElapsed());
+    }
+
+private:
+    Q_DISABLE_COPY(PerfScope)
+
+    PerfCounters* counters_;
+    PerfCounters::Probe probe_;
+    QElapsedTimer timer_;
+};
+
+#define PERF_SCOPE(counters, probe) PerfScope perf_scope_((counters), PerfCounters::probe)
+
+#else
+#define PERF_SCOPE(counters, probe)
+#endif
+
+#endif // PERFCOUNTERS_H_
@@ -5,13 +5,21 @@
 #include <QTextCodec>
 
 StyleResourcePool::StyleResourcePool()
+    : palette_serial_(0)
 {
-    color_map_["normal_text_font"] = QColor(255, 255, 255, 255 * 0.8);
-    color_map_["main_color"] = QColor(49, 152, 255);
-    color_map_["normal_text_highlight_on_dark_font"] = QColor(255, 255, 255, 255 * 0.9);
-    color_map_["normal_table_item_range"] = QColor(35, 68, 120);
-    color_map_["normal_white"] = QColor(255, 255, 255);
-    color_map_["normal_pop_border"] = QColor(0, 0, 0);
+    color_tokens_["normal_text_font"] = kNormalTextFont;
+    color_tokens_["main_color"] = kMainColor;
+    color_tokens_["normal_text_highlight_on_dark_font"] = kNormalTextHighlightOnDarkFont;
+    color_tokens_["normal_table_item_range"] = kNormalTableItemRange;
+    color_tokens_["normal_white"] = kNormalWhite;
+    color_tokens_["normal_pop_border"] = kNormalPopBorder;
+
+    palette_[kNormalTextFont] = QColor(255, 255, 255, 255 * 0.8);
+    palette_[kMainColor] = QColor(49, 152, 255);
+    palette_[kNormalTextHighlightOnDarkFont] = QColor(255, 255, 255, 255 * 0.9);
+    palette_[kNormalTableItemRange] = QColor(35, 68, 120);
+    palette_[kNormalWhite] = QColor(255, 255, 255);
+    palette_[kNormalPopBorder] = QColor(0, 0, 0);
 
     LoadStyleText();
 }
@@ -42,8 +50,20 @@ QString StyleResourcePool::GetText(const QString& key)
 
 QColor StyleResourcePool::GetColor(const QString& text)
 {
-    if (!color_map_.contains(text))
+    auto it = color_tokens_.constFind(text);
+    if (it == color_tokens_.constEnd())
         return QColor();
 
-    return color_map_[text];
+    return palette_[it.value()];
+}
+
+void StyleResourcePool::SetPalette(const Palette& palette)
+{
+    // Ԫֻɫ, ʱȡɫ, 滻ɫػ漴Ч
+    palette_ = palette;
+    ++palette_serial_;
+
+    for (auto widget : QApplication::topLevelWidgets()) {
+        widget->update();
+    }
 }
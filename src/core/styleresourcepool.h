@@ -5,16 +5,40 @@
 #include <QMap>
 #include <QSettings>
 #include <QWidget>
+#include <array>
+#include <memory>
+
+#include "datetimeedit_global.h"
 
 #define GET_COLOR(text) StyleResourcePool::Instance()->GetColor(text)
 #define GET_TXT(text) StyleResourcePool::Instance()->GetText(text)
 
-class StyleResourcePool
+class DATETIMEEDIT_EXPORT StyleResourcePool
 {
 public:
+    // ɫɫ, ֱɫ, ƵƵôʹ
+    enum ColorToken : quint8
+    {
+        kNormalTextFont,
+        kMainColor,
+        kNormalTextHighlightOnDarkFont,
+        kNormalTableItemRange,
+        kNormalWhite,
+        kNormalPopBorder,
+        kColorTokenCount
+    };
+    using Palette = std::array<QColor, kColorTokenCount>;
+
     static StyleResourcePool* Instance();
 
     QColor GetColor(const QString& text);
+    const QColor& GetColor(ColorToken token) const { return palette_[token]; }
+
+    // 滻ɫ(л), ػд
+    void SetPalette(const Palette& palette);
+    const Palette& GetPalette() const { return palette_; }
+    // ÿ滻ɫ, жϰɫλͼǷʧЧ
+    quint32 PaletteSerial() const { return palette_serial_; }
 
     bool LoadStyleText();
     QString GetText(const QString& key);
@@ -24,7 +48,9 @@ private:
     StyleResourcePool();
 
 private:
-    QMap<QString, QColor> color_map_;
+    Palette palette_;
+    quint32 palette_serial_;
+    QMap<QString, ColorToken> color_tokens_;
     std::unique_ptr<QSettings> txt_settings_;
 };
 
@@ -0,0 +1,45 @@
+#include <QtTest>
+
+#include "datetimecodec.h"
+
+class DateTimeCodecTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fixedLayoutRoundTrip();
+    void nonAsciiLiteralFallsBack();
+};
+
+void DateTimeCodecTest::fixedLayoutRoundTrip()
+{
+    DateTimeCodec codec("yyyy-MM-dd hh:mm:ss");
+    QVERIFY(codec.isFixedLayout());
+
+    QDateTime date_time(QDate(2024, 3, 2), QTime(8, 5, 9));
+    QCOMPARE(codec.toString(date_time), QString("2024-03-02 08:05:09"));
+    QCOMPARE(codec.fromString("2024-03-02 08:05:09"), date_time);
+}
+
+void DateTimeCodecTest::nonAsciiLiteralFallsBack()
+{
+    // yyyyMMdd hh:mm:ss
+    const QString format = QString::fromUtf16(u"yyyy\u5e74MM\u6708dd\u65e5 hh:mm:ss");
+    DateTimeCodec codec(format);
+    QVERIFY(!codec.isFixedLayout());
+    QCOMPARE(codec.width(), 0);
+
+    QDateTime date_time(QDate(2024, 3, 2), QTime(8, 5, 9));
+    // 20240302 08:05:09
+    const QString text = QString::fromUtf16(u"2024\u5e7403\u670802\u65e5 08:05:09");
+    QCOMPARE(codec.toString(date_time), text);
+    QCOMPARE(codec.fromString(text), date_time);
+
+    // ӿֶֻ֧ʽ
+    qint64 secs = 0;
+    QCOMPARE(codec.formatBatch(&secs, 1, nullptr, 0), 0);
+}
+
+QTEST_APPLESS_MAIN(DateTimeCodecTest)
+
+#include "datetimecodec_test.moc"